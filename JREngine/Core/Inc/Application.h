@@ -9,29 +9,41 @@ class Application
 public:
 	Application();
 	virtual ~Application();
+#if defined(CORE_PLATFORM_WINDOWS)
 	void Initialize(HINSTANCE instance, LPCSTR appName, uint32_t width, uint32_t height);
+#endif
+	// Starts the application without a window or GPU, OnInitialize receives a zero size
+	void InitializeHeadless(const char* appName);
 	void Terminate();
 
+#if defined(CORE_PLATFORM_WINDOWS)
 	void HookWindow(HWND hWnd);
 	void UnhookWindow();
+#endif
 
 	void Update();
 
 	void Kill() { mRunning = false; }
 
+#if defined(CORE_PLATFORM_WINDOWS)
 	HINSTANCE GetInstance() const { return mInstance; }
 	HWND GetWindow() const { return mWindow; }
+#endif
 	const char* GetAppName() const { return mAppName.c_str(); }
 	bool IsRunning() { return mRunning; }
+	bool IsHeadless() const { return mHeadless; }
 private:
 	virtual void OnInitialize(uint32_t width, uint32_t height) = 0;
 	virtual void OnTerminate() = 0;
 	virtual void OnUpdate() = 0;
 private:
+#if defined(CORE_PLATFORM_WINDOWS)
 	HINSTANCE mInstance;
 	HWND mWindow;
+#endif
 	std::string mAppName;
 	bool mRunning;
+	bool mHeadless;
 }; // class Application
 
 } //namespace Core
\ No newline at end of file
@@ -22,7 +22,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum>::type
 operator &(Enum lhs, Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	return static_cast<Enum>
 		(static_cast<underType>(lhs)
@@ -33,7 +33,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum>::type
 operator ^(Enum lhs, Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	return static_cast<Enum>
 		(static_cast<underType>(lhs)
@@ -44,7 +44,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum>::type
 operator ~(Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	return static_cast<Enum>
 		(~static_cast<underType>(rhs));
@@ -54,7 +54,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum&>::type
 operator |=(Enum& lhs, Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	lhs = static_cast<Enum>
 		(static_cast<underType>(lhs)
@@ -67,7 +67,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum&>::type
 operator &=(Enum& lhs, Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	lhs = static_cast<Enum>
 		(static_cast<underType>(lhs)
@@ -80,7 +80,7 @@ template<typename Enum>
 inline typename std::enable_if<std::is_enum<decltype(Enum::enable_bit_flags)>::value, Enum&>::type
 operator ^=(Enum& lhs, Enum rhs)
 {
-	using underType = std::underlying_type<Enum>::type;
+	using underType = typename std::underlying_type<Enum>::type;
 
 	lhs = static_cast<Enum>
 		(static_cast<underType>(lhs)
@@ -1,4 +1,6 @@
 #pragma once
+#include "MemoryTracker.h"
+
 #include <vector>
 
 namespace Core
@@ -7,7 +9,7 @@ namespace Core
 class BlockAllocator
 {
 public:
-	BlockAllocator(unsigned int blockSize, unsigned int blockCapacity);
+	BlockAllocator(unsigned int blockSize, unsigned int blockCapacity, MemoryCategory category = MemoryCategory::General);
 	~BlockAllocator();
 
 	BlockAllocator(const BlockAllocator& copy) = delete;
@@ -16,11 +18,23 @@ public:
 	void* Allocate();
 	void Free(void* ptr);
 
+	unsigned int GetBlockSize() const { return mSize; }
+	unsigned int GetCapacity() const { return mCapacity; }
+	unsigned int GetUsedCount() const { return mCapacity - static_cast<unsigned int>(mFreeSlots.size()); }
+	unsigned int GetPeakUsedCount() const { return mPeakUsed; }
+	unsigned int GetAllocationCount() const { return mAllocationCount; }
+	unsigned int GetFailedAllocationCount() const { return mFailedCount; }
+
 protected:
 	void* mData;
 	unsigned int mSize, mCapacity;
 	std::vector<unsigned int> mFreeSlots;
 
+	MemoryCategory mCategory;
+	unsigned int mPeakUsed;
+	unsigned int mAllocationCount;
+	unsigned int mFailedCount;
+
 }; // class BlockAllocator
 
 } // namespace Core
\ No newline at end of file
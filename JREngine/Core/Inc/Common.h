@@ -1,13 +1,18 @@
 #pragma once
 
-#include <Windows.h>
+#include "Platform.h"
+
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 //STL
 #include <algorithm>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
\ No newline at end of file
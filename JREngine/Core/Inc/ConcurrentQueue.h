@@ -0,0 +1,413 @@
+#pragma once
+
+#include "Common.h"
+#include "Debug.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core
+{
+
+// Size used to pad shared indices apart so producers and consumers do not
+// invalidate each other's cache lines.
+constexpr size_t kCacheLineSize = 64;
+
+inline uint32_t NextPowerOfTwo(uint32_t value)
+{
+	uint32_t result = 1;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+
+/*
+Bounded single-producer/single-consumer ring buffer. Exactly one thread may
+push and exactly one (other) thread may pop. Capacity is rounded up to a
+power of two so indices wrap with a mask. Each side keeps a private copy of
+the other side's index and only reloads it when the copy says the queue is
+full (or empty), so most calls never touch the other thread's cache line.
+*/
+template<typename T>
+class SpscQueue
+{
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	alignas(kCacheLineSize) std::atomic<uint32_t> mHead; // next slot to pop, written by consumer
+	uint32_t mTailCache; // consumer's last view of mTail
+	alignas(kCacheLineSize) std::atomic<uint32_t> mTail; // next slot to push, written by producer
+	uint32_t mHeadCache; // producer's last view of mHead
+	alignas(kCacheLineSize) Storage* mBuffer;
+	uint32_t mMask;
+
+public:
+	SpscQueue(uint32_t capacity);
+	~SpscQueue();
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	bool TryPush(const T& value) { return Emplace(value); }
+	bool TryPush(T&& value) { return Emplace(std::move(value)); }
+	bool TryPop(T& value);
+
+	// returns how many of the items were pushed/popped
+	uint32_t PushBatch(const T* values, uint32_t count);
+	uint32_t PopBatch(T* values, uint32_t maxCount);
+
+	uint32_t Size() const { return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire); }
+	uint32_t Capacity() const { return mMask + 1; }
+	bool IsEmpty() const { return Size() == 0; }
+
+private:
+	template<typename U>
+	bool Emplace(U&& value);
+
+	T* Slot(uint32_t index) { return reinterpret_cast<T*>(&mBuffer[index & mMask]); }
+
+}; // class SpscQueue
+
+/*
+Bounded multi-producer/multi-consumer ring buffer. Every cell carries a
+sequence number that tells producers and consumers whose turn it is, so the
+only contended operation is a compare-exchange on the head or tail index.
+
+The batch calls claim a whole run of cells with one compare-exchange. They
+only take cells that are ready the way TryPush and TryPop check a single
+one, so like those they never wait on another thread. A batch stops short
+at the first cell still being written or read.
+*/
+template<typename T>
+class MpmcQueue
+{
+	struct Cell
+	{
+		std::atomic<uint32_t> sequence;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+	};
+
+	alignas(kCacheLineSize) std::atomic<uint32_t> mHead;
+	alignas(kCacheLineSize) std::atomic<uint32_t> mTail;
+	alignas(kCacheLineSize) Cell* mCells;
+	uint32_t mMask;
+
+public:
+	MpmcQueue(uint32_t capacity);
+	~MpmcQueue();
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	bool TryPush(const T& value) { return Emplace(value); }
+	bool TryPush(T&& value) { return Emplace(std::move(value)); }
+	bool TryPop(T& value);
+
+	// returns how many of the items were pushed/popped, stopping at the first
+	// cell another thread is still busy with
+	uint32_t PushBatch(const T* values, uint32_t count);
+	uint32_t PopBatch(T* values, uint32_t maxCount);
+
+	// only a snapshot when other threads are active
+	uint32_t Size() const { return mTail.load(std::memory_order_relaxed) - mHead.load(std::memory_order_relaxed); }
+	uint32_t Capacity() const { return mMask + 1; }
+
+private:
+	template<typename U>
+	bool Emplace(U&& value);
+
+}; // class MpmcQueue
+
+//---------SpscQueue---------
+
+template<typename T>
+SpscQueue<T>::SpscQueue(uint32_t capacity)
+	: mHead{ 0 }
+	, mTailCache{ 0 }
+	, mTail{ 0 }
+	, mHeadCache{ 0 }
+{
+	ASSERT(capacity > 0, "[SpscQueue] Invalid capacity.");
+	capacity = NextPowerOfTwo(capacity);
+	mBuffer = static_cast<Storage*>(std::malloc(sizeof(Storage) * capacity));
+	mMask = capacity - 1;
+}
+
+template<typename T>
+SpscQueue<T>::~SpscQueue()
+{
+	// destruct anything left behind
+	uint32_t head = mHead.load(std::memory_order_relaxed);
+	const uint32_t tail = mTail.load(std::memory_order_relaxed);
+	for (; head != tail; ++head)
+	{
+		Slot(head)->~T();
+	}
+	std::free(mBuffer);
+}
+
+template<typename T>
+template<typename U>
+bool SpscQueue<T>::Emplace(U&& value)
+{
+	const uint32_t tail = mTail.load(std::memory_order_relaxed);
+	if (tail - mHeadCache > mMask)
+	{
+		mHeadCache = mHead.load(std::memory_order_acquire);
+		if (tail - mHeadCache > mMask)
+		{
+			return false;
+		}
+	}
+	new(Slot(tail)) T(std::forward<U>(value));
+	mTail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+bool SpscQueue<T>::TryPop(T& value)
+{
+	const uint32_t head = mHead.load(std::memory_order_relaxed);
+	if (head == mTailCache)
+	{
+		mTailCache = mTail.load(std::memory_order_acquire);
+		if (head == mTailCache)
+		{
+			return false;
+		}
+	}
+	T* slot = Slot(head);
+	value = std::move(*slot);
+	slot->~T();
+	mHead.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+uint32_t SpscQueue<T>::PushBatch(const T* values, uint32_t count)
+{
+	const uint32_t tail = mTail.load(std::memory_order_relaxed);
+	uint32_t freeSlots = Capacity() - (tail - mHeadCache);
+	if (freeSlots < count)
+	{
+		mHeadCache = mHead.load(std::memory_order_acquire);
+		freeSlots = Capacity() - (tail - mHeadCache);
+	}
+	const uint32_t pushCount = count < freeSlots ? count : freeSlots;
+	for (uint32_t i = 0; i < pushCount; ++i)
+	{
+		new(Slot(tail + i)) T(values[i]);
+	}
+	// publish the whole batch with a single store
+	mTail.store(tail + pushCount, std::memory_order_release);
+	return pushCount;
+}
+
+template<typename T>
+uint32_t SpscQueue<T>::PopBatch(T* values, uint32_t maxCount)
+{
+	const uint32_t head = mHead.load(std::memory_order_relaxed);
+	uint32_t available = mTailCache - head;
+	if (available < maxCount)
+	{
+		mTailCache = mTail.load(std::memory_order_acquire);
+		available = mTailCache - head;
+	}
+	const uint32_t popCount = maxCount < available ? maxCount : available;
+	for (uint32_t i = 0; i < popCount; ++i)
+	{
+		T* slot = Slot(head + i);
+		values[i] = std::move(*slot);
+		slot->~T();
+	}
+	mHead.store(head + popCount, std::memory_order_release);
+	return popCount;
+}
+
+//---------MpmcQueue---------
+
+template<typename T>
+MpmcQueue<T>::MpmcQueue(uint32_t capacity)
+	: mHead{ 0 }
+	, mTail{ 0 }
+{
+	ASSERT(capacity > 1, "[MpmcQueue] Capacity must be at least two.");
+	capacity = NextPowerOfTwo(capacity);
+	mCells = static_cast<Cell*>(std::malloc(sizeof(Cell) * capacity));
+	mMask = capacity - 1;
+	for (uint32_t i = 0; i < capacity; ++i)
+	{
+		new(&mCells[i].sequence) std::atomic<uint32_t>(i);
+	}
+}
+
+template<typename T>
+MpmcQueue<T>::~MpmcQueue()
+{
+	// no other thread may touch the queue at this point
+	uint32_t head = mHead.load(std::memory_order_relaxed);
+	const uint32_t tail = mTail.load(std::memory_order_relaxed);
+	for (; head != tail; ++head)
+	{
+		reinterpret_cast<T*>(&mCells[head & mMask].data)->~T();
+	}
+	std::free(mCells);
+}
+
+template<typename T>
+template<typename U>
+bool MpmcQueue<T>::Emplace(U&& value)
+{
+	uint32_t tail = mTail.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = mCells[tail & mMask];
+		const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+		const int32_t diff = static_cast<int32_t>(sequence - tail);
+		if (diff == 0)
+		{
+			// cell is free for this lap, try to claim it
+			if (mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+			{
+				new(&cell.data) T(std::forward<U>(value));
+				cell.sequence.store(tail + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+		{
+			// consumer has not freed this cell yet, queue is full
+			return false;
+		}
+		else
+		{
+			tail = mTail.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T>
+bool MpmcQueue<T>::TryPop(T& value)
+{
+	uint32_t head = mHead.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell& cell = mCells[head & mMask];
+		const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+		const int32_t diff = static_cast<int32_t>(sequence - (head + 1));
+		if (diff == 0)
+		{
+			if (mHead.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+			{
+				T* data = reinterpret_cast<T*>(&cell.data);
+				value = std::move(*data);
+				data->~T();
+				// hand the cell back to producers for the next lap
+				cell.sequence.store(head + mMask + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false;
+		}
+		else
+		{
+			head = mHead.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T>
+uint32_t MpmcQueue<T>::PushBatch(const T* values, uint32_t count)
+{
+	uint32_t tail = mTail.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// take the run of cells from tail on that are already free for this lap;
+		// none of them can change hands before tail moves past them
+		uint32_t pushCount = 0;
+		int32_t diff = 0;
+		while (pushCount < count)
+		{
+			const uint32_t position = tail + pushCount;
+			diff = static_cast<int32_t>(mCells[position & mMask].sequence.load(std::memory_order_acquire) - position);
+			if (diff != 0)
+			{
+				break;
+			}
+			++pushCount;
+		}
+
+		if (pushCount == 0)
+		{
+			if (count == 0 || diff < 0)
+			{
+				// consumer has not freed the next cell yet, queue is full
+				return 0;
+			}
+			tail = mTail.load(std::memory_order_relaxed);
+		}
+		else if (mTail.compare_exchange_weak(tail, tail + pushCount, std::memory_order_relaxed))
+		{
+			for (uint32_t i = 0; i < pushCount; ++i)
+			{
+				Cell& cell = mCells[(tail + i) & mMask];
+				new(&cell.data) T(values[i]);
+				cell.sequence.store(tail + i + 1, std::memory_order_release);
+			}
+			return pushCount;
+		}
+	}
+}
+
+template<typename T>
+uint32_t MpmcQueue<T>::PopBatch(T* values, uint32_t maxCount)
+{
+	uint32_t head = mHead.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// take the run of cells from head on whose producers have finished
+		uint32_t popCount = 0;
+		int32_t diff = 0;
+		while (popCount < maxCount)
+		{
+			const uint32_t position = head + popCount;
+			diff = static_cast<int32_t>(mCells[position & mMask].sequence.load(std::memory_order_acquire) - (position + 1));
+			if (diff != 0)
+			{
+				break;
+			}
+			++popCount;
+		}
+
+		if (popCount == 0)
+		{
+			if (maxCount == 0 || diff < 0)
+			{
+				return 0;
+			}
+			head = mHead.load(std::memory_order_relaxed);
+		}
+		else if (mHead.compare_exchange_weak(head, head + popCount, std::memory_order_relaxed))
+		{
+			for (uint32_t i = 0; i < popCount; ++i)
+			{
+				Cell& cell = mCells[(head + i) & mMask];
+				T* data = reinterpret_cast<T*>(&cell.data);
+				values[i] = std::move(*data);
+				data->~T();
+				// hand the cell back to producers for the next lap
+				cell.sequence.store(head + i + mMask + 1, std::memory_order_release);
+			}
+			return popCount;
+		}
+	}
+}
+
+} // namespace Core
\ No newline at end of file
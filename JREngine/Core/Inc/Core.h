@@ -7,14 +7,24 @@
 #include "BitMask.h"
 #include "Debug.h"
 #include "DeleteUtil.h"
+#include "Hash.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
 #include "Timer.h"
 #include "Window.h"
 
 // Memory
 
 #include "BlockAllocator.h"
+#include "MemoryTracker.h"
 #include "TypedAllocator.h"
 
 #include "HandlePool.h"
 
+// Containers
+
+#include "ConcurrentQueue.h"
+#include "FixedVector.h"
+#include "InlineVector.h"
+
 #endif // #ifndef INCLUDED_CORE_H
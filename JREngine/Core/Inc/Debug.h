@@ -1,19 +1,32 @@
 #ifndef INCLUDED_CORE_DEBUG_H
 #define INCLUDED_CORE_DEBUG_H
 
-#if defined(_CONSOLE)
-	#define LOGPRINT printf
-#else 
+#include "Platform.h"
+
+#include <cstdio>
+
+#if defined(CORE_PLATFORM_WINDOWS) && !defined(_CONSOLE)
 	#define LOGPRINT OutputDebugStringA
+#else
+	#define LOGPRINT(message) fputs(message, stderr)
 #endif
 
+// printf through LOGPRINT, in every build and without LOG's newline; for
+// reports that are asked for explicitly
+#define LOGPRINTF(format, ...)\
+	{\
+		char buffer[1024];\
+		snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__);\
+		LOGPRINT(buffer);\
+	}
+
 #if defined(_DEBUG)
 #define LOG(format, ...)\
 	{\
 		char buffer[1024];\
-		int ret = _snprintf_s(buffer, _countof(buffer), _TRUNCATE, (#format), __VA_ARGS__);\
+		int ret = snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__);\
 		LOGPRINT(buffer);\
-		if (ret == -1) OutputDebugStringA("** message truncated **\n");\
+		if (ret < 0 || ret >= static_cast<int>(sizeof(buffer))) LOGPRINT("** message truncated **\n");\
 		LOGPRINT("\n");\
 	}
 
@@ -21,13 +34,13 @@
 	{\
 		if (!(condition))\
 		{\
-			LOG(format, __VA_ARGS__)\
-			DebugBreak();\
+			LOG(format, ##__VA_ARGS__)\
+			CORE_DEBUG_BREAK();\
 		}\
 	}
 
 #define VERIFY(condition, format, ...)\
-	ASSERT(condition, format, __VA_ARGS__)
+	ASSERT(condition, format, ##__VA_ARGS__)
 #else
 #define LOG(format, ...)
 #define ASSERT(condition, format, ...)
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Common.h"
+#include "Debug.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core
+{
+
+/*
+Vector with a hard capacity of N elements stored inside the object. It never
+touches the heap; pushing past the capacity is an error.
+*/
+template<typename T, uint32_t N>
+class FixedVector
+{
+	static_assert(N > 0, "[FixedVector] Capacity must be above zero.");
+
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	Storage mStorage[N];
+	uint32_t mSize;
+
+public:
+	using value_type = T;
+	using size_type = uint32_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	FixedVector() : mSize{ 0 } {}
+	FixedVector(std::initializer_list<T> list);
+	~FixedVector() { clear(); }
+
+	FixedVector(const FixedVector& copy);
+	FixedVector& operator=(const FixedVector& copy);
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_back();
+	iterator erase(const_iterator position);
+	void clear();
+
+	T& operator[](uint32_t index) { ASSERT(index < mSize, "[FixedVector] Index out of range."); return data()[index]; }
+	const T& operator[](uint32_t index) const { ASSERT(index < mSize, "[FixedVector] Index out of range."); return data()[index]; }
+
+	T& front() { return data()[0]; }
+	const T& front() const { return data()[0]; }
+	T& back() { return data()[mSize - 1]; }
+	const T& back() const { return data()[mSize - 1]; }
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + mSize; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + mSize; }
+
+	T* data() { return reinterpret_cast<T*>(mStorage); }
+	const T* data() const { return reinterpret_cast<const T*>(mStorage); }
+
+	uint32_t size() const { return mSize; }
+	static constexpr uint32_t capacity() { return N; }
+	bool empty() const { return mSize == 0; }
+	bool full() const { return mSize == N; }
+
+}; // class FixedVector
+
+template<typename T, uint32_t N>
+FixedVector<T, N>::FixedVector(std::initializer_list<T> list)
+	: mSize{ 0 }
+{
+	for (auto& element : list)
+	{
+		emplace_back(element);
+	}
+}
+
+template<typename T, uint32_t N>
+FixedVector<T, N>::FixedVector(const FixedVector& copy)
+	: mSize{ 0 }
+{
+	for (auto& element : copy)
+	{
+		emplace_back(element);
+	}
+}
+
+template<typename T, uint32_t N>
+FixedVector<T, N>& FixedVector<T, N>::operator=(const FixedVector& copy)
+{
+	if (this != &copy)
+	{
+		clear();
+		for (auto& element : copy)
+		{
+			emplace_back(element);
+		}
+	}
+	return *this;
+}
+
+template<typename T, uint32_t N>
+template<typename... Args>
+T& FixedVector<T, N>::emplace_back(Args&&... args)
+{
+	ASSERT(mSize < N, "[FixedVector] Capacity exceeded.");
+	T* element = new(data() + mSize) T(std::forward<Args>(args)...);
+	++mSize;
+	return *element;
+}
+
+template<typename T, uint32_t N>
+void FixedVector<T, N>::pop_back()
+{
+	ASSERT(mSize > 0, "[FixedVector] Cannot pop from an empty vector.");
+	--mSize;
+	data()[mSize].~T();
+}
+
+template<typename T, uint32_t N>
+typename FixedVector<T, N>::iterator FixedVector<T, N>::erase(const_iterator position)
+{
+	ASSERT(position >= begin() && position < end(), "[FixedVector] Invalid erase position.");
+
+	T* iter = data() + (position - data());
+	for (T* next = iter + 1; next != end(); ++next)
+	{
+		*(next - 1) = std::move(*next);
+	}
+	pop_back();
+	return iter;
+}
+
+template<typename T, uint32_t N>
+void FixedVector<T, N>::clear()
+{
+	for (uint32_t i = 0; i < mSize; ++i)
+	{
+		data()[i].~T();
+	}
+	mSize = 0;
+}
+
+} // namespace Core
\ No newline at end of file
@@ -25,6 +25,11 @@ public:
 	DataType* Get() const;
 	DataType* operator->() const;
 
+	// index and generation packed together, unique among live handles and never 0 for them
+	uint32_t GetId() const { return (static_cast<uint32_t>(mGeneration) << 24) | mIndex; }
+	// the handle a GetId value came from, e.g. after reading it back from a file
+	static Handle FromId(uint32_t id);
+
 	bool operator==(Handle rhs) const { return mIndex == rhs.mIndex && mGeneration == rhs.mGeneration; }
 	bool operator!=(Handle rhs) const { return !(*this == rhs); }
 };
@@ -35,9 +40,12 @@ class HandlePool
 	struct Entry
 	{
 		DataType* instance = nullptr;
-		uint32_t generation = 0;
+		uint32_t generation = 0; // of the current instance, handles keep the low 8 bits
+		uint32_t nextGeneration = 0; // only ever counts up, so no generation is handed out twice
 	};
 
+	static const uint32_t kGenerationMask = 0xff;
+
 	std::vector<Entry> mEntries;
 	std::vector<uint32_t> mFreeSlots;
 
@@ -49,6 +57,11 @@ public:
 
 	HandleType Register(DataType* instance);
 	void Unregister(HandleType handle);
+	// registers instance under a handle handed out earlier and since
+	// unregistered, so old copies of the handle find it again; fails if the
+	// slot is in use. Handles given out for the slot in between stay invalid.
+	// Searches the free list, meant for occasional use.
+	bool Restore(HandleType handle, DataType* instance);
 
 	bool IsValid(HandleType handle) const;
 	DataType* Get(HandleType handle);
@@ -65,6 +78,15 @@ Handle<DataType>::Handle()
 {
 }
 
+template<class DataType>
+Handle<DataType> Handle<DataType>::FromId(uint32_t id)
+{
+	Handle handle;
+	handle.mIndex = id & 0xffffff;
+	handle.mGeneration = id >> 24;
+	return handle;
+}
+
 template<class DataType>
 bool Handle<DataType>::IsValid() const
 {
@@ -127,12 +149,14 @@ Handle<DataType> HandlePool<DataType>::Register(DataType* instance)
 	mFreeSlots.pop_back();
 
 	// register instance
-	mEntries[slot].instance = instance;
+	Entry& entry = mEntries[slot];
+	entry.instance = instance;
+	entry.generation = entry.nextGeneration++;
 
 	// create handle to entry
 	HandleType handle;
 	handle.mIndex = slot;
-	handle.mGeneration = mEntries[slot].generation;
+	handle.mGeneration = entry.generation & kGenerationMask;
 
 	return handle;
 }
@@ -142,15 +166,57 @@ void HandlePool<DataType>::Unregister(HandleType handle)
 {
 	if (IsValid(handle))
 	{
-		mEntries[handle.mIndex].generation++;
+		mEntries[handle.mIndex].instance = nullptr;
 		mFreeSlots.push_back(handle.mIndex);
 	}
 }
 
+template<class DataType>
+bool HandlePool<DataType>::Restore(HandleType handle, DataType* instance)
+{
+	ASSERT(instance != nullptr, "[HandlePool] Invalid instance.");
+
+	// slot 0 is never handed out
+	if (handle.mIndex == 0 || handle.mIndex >= mEntries.size() || mEntries[handle.mIndex].instance != nullptr)
+	{
+		return false;
+	}
+
+	auto iter = std::find(mFreeSlots.begin(), mFreeSlots.end(), static_cast<uint32_t>(handle.mIndex));
+	ASSERT(iter != mFreeSlots.end(), "[HandlePool] Unused slot is missing from the free list.");
+	*iter = mFreeSlots.back();
+	mFreeSlots.pop_back();
+
+	// the latest generation the slot gave out with the handle's low bits, or
+	// one it has not reached yet (e.g. when loading into a fresh world). The
+	// counter never goes back, so generations handed out in between are not
+	// given out again once instance is unregistered.
+	Entry& entry = mEntries[handle.mIndex];
+	const uint32_t lowBits = handle.mGeneration;
+	if (entry.nextGeneration > lowBits)
+	{
+		const uint32_t latest = entry.nextGeneration - 1;
+		entry.generation = latest - ((latest - lowBits) & kGenerationMask);
+	}
+	else
+	{
+		entry.generation = lowBits;
+		entry.nextGeneration = lowBits + 1;
+	}
+	entry.instance = instance;
+	return true;
+}
+
 template<class DataType>
 bool HandlePool<DataType>::IsValid(HandleType handle) const
 {
-	return handle != HandleType() && mEntries[handle.mIndex].generation == handle.mGeneration;
+	// ids read back from a file may point anywhere
+	if (handle == HandleType() || handle.mIndex >= mEntries.size())
+	{
+		return false;
+	}
+	const Entry& entry = mEntries[handle.mIndex];
+	return entry.instance != nullptr && (entry.generation & kGenerationMask) == handle.mGeneration;
 }
 
 template<class DataType>
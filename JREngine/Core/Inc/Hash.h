@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core
+{
+
+// FNV-1a over a null-terminated string, lets string keyed tables be searched
+// without building a std::string
+inline uint32_t HashString(const char* str)
+{
+	uint32_t hash = 2166136261u;
+	for (; *str; ++str)
+	{
+		hash = (hash ^ static_cast<uint8_t>(*str)) * 16777619u;
+	}
+	return hash;
+}
+
+} // namespace Core
\ No newline at end of file
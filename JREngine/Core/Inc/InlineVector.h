@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Common.h"
+#include "Debug.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Core
+{
+
+/*
+Vector that keeps its first N elements inside the object itself and only
+spills to the heap once that capacity is exceeded. Meant for the small
+per-object arrays (children, components, callbacks) that are iterated every
+frame and almost never grow past a handful of elements.
+*/
+template<typename T, uint32_t N>
+class InlineVector
+{
+	static_assert(N > 0, "[InlineVector] Inline capacity must be above zero.");
+	// the heap block comes from std::malloc
+	static_assert(alignof(T) <= alignof(std::max_align_t), "[InlineVector] Over-aligned types are not supported.");
+
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	Storage mInline[N];
+	T* mData;
+	uint32_t mSize;
+	uint32_t mCapacity;
+
+public:
+	using value_type = T;
+	using size_type = uint32_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	InlineVector();
+	InlineVector(std::initializer_list<T> list);
+	~InlineVector();
+
+	InlineVector(const InlineVector& copy);
+	InlineVector(InlineVector&& other);
+	InlineVector& operator=(const InlineVector& copy);
+	InlineVector& operator=(InlineVector&& other);
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args);
+
+	void pop_back();
+	iterator erase(const_iterator position);
+	void clear();
+	void reserve(uint32_t capacity);
+
+	T& operator[](uint32_t index) { ASSERT(index < mSize, "[InlineVector] Index out of range."); return mData[index]; }
+	const T& operator[](uint32_t index) const { ASSERT(index < mSize, "[InlineVector] Index out of range."); return mData[index]; }
+
+	T& front() { return mData[0]; }
+	const T& front() const { return mData[0]; }
+	T& back() { return mData[mSize - 1]; }
+	const T& back() const { return mData[mSize - 1]; }
+
+	iterator begin() { return mData; }
+	iterator end() { return mData + mSize; }
+	const_iterator begin() const { return mData; }
+	const_iterator end() const { return mData + mSize; }
+
+	T* data() { return mData; }
+	const T* data() const { return mData; }
+
+	uint32_t size() const { return mSize; }
+	uint32_t capacity() const { return mCapacity; }
+	bool empty() const { return mSize == 0; }
+
+	// true while the elements still live in the object's own storage
+	bool IsInline() const { return mData == InlineData(); }
+
+private:
+	T* InlineData() { return reinterpret_cast<T*>(mInline); }
+	const T* InlineData() const { return reinterpret_cast<const T*>(mInline); }
+
+	T* Allocate(uint32_t capacity);
+	// moves the elements into data and takes it as the new storage
+	void Adopt(T* data, uint32_t capacity);
+	void Grow(uint32_t capacity) { Adopt(Allocate(capacity), capacity); }
+	void Release();
+
+}; // class InlineVector
+
+template<typename T, uint32_t N>
+InlineVector<T, N>::InlineVector()
+	: mData{ InlineData() }
+	, mSize{ 0 }
+	, mCapacity{ N }
+{
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>::InlineVector(std::initializer_list<T> list)
+	: InlineVector()
+{
+	reserve(static_cast<uint32_t>(list.size()));
+	for (auto& element : list)
+	{
+		emplace_back(element);
+	}
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>::~InlineVector()
+{
+	Release();
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>::InlineVector(const InlineVector& copy)
+	: InlineVector()
+{
+	reserve(copy.mSize);
+	for (auto& element : copy)
+	{
+		emplace_back(element);
+	}
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>::InlineVector(InlineVector&& other)
+	: InlineVector()
+{
+	*this = std::move(other);
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>& InlineVector<T, N>::operator=(const InlineVector& copy)
+{
+	if (this != &copy)
+	{
+		clear();
+		reserve(copy.mSize);
+		for (auto& element : copy)
+		{
+			emplace_back(element);
+		}
+	}
+	return *this;
+}
+
+template<typename T, uint32_t N>
+InlineVector<T, N>& InlineVector<T, N>::operator=(InlineVector&& other)
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	Release();
+
+	if (other.IsInline())
+	{
+		// inline elements have to be moved one by one
+		for (uint32_t i = 0; i < other.mSize; ++i)
+		{
+			new(InlineData() + i) T(std::move(other.mData[i]));
+		}
+		mSize = other.mSize;
+		other.clear();
+	}
+	else
+	{
+		// heap block can simply change owner
+		mData = other.mData;
+		mSize = other.mSize;
+		mCapacity = other.mCapacity;
+
+		other.mData = other.InlineData();
+		other.mSize = 0;
+		other.mCapacity = N;
+	}
+	return *this;
+}
+
+template<typename T, uint32_t N>
+template<typename... Args>
+T& InlineVector<T, N>::emplace_back(Args&&... args)
+{
+	if (mSize == mCapacity)
+	{
+		// construct before moving the old elements, args may refer to one of them
+		const uint32_t capacity = mCapacity * 2;
+		T* data = Allocate(capacity);
+		T* element = new(data + mSize) T(std::forward<Args>(args)...);
+		Adopt(data, capacity);
+		++mSize;
+		return *element;
+	}
+	T* element = new(mData + mSize) T(std::forward<Args>(args)...);
+	++mSize;
+	return *element;
+}
+
+template<typename T, uint32_t N>
+void InlineVector<T, N>::pop_back()
+{
+	ASSERT(mSize > 0, "[InlineVector] Cannot pop from an empty vector.");
+	--mSize;
+	mData[mSize].~T();
+}
+
+template<typename T, uint32_t N>
+typename InlineVector<T, N>::iterator InlineVector<T, N>::erase(const_iterator position)
+{
+	ASSERT(position >= begin() && position < end(), "[InlineVector] Invalid erase position.");
+
+	// shift the tail down by one, keeping element order
+	T* iter = mData + (position - mData);
+	for (T* next = iter + 1; next != end(); ++next)
+	{
+		*(next - 1) = std::move(*next);
+	}
+	pop_back();
+	return iter;
+}
+
+template<typename T, uint32_t N>
+void InlineVector<T, N>::clear()
+{
+	for (uint32_t i = 0; i < mSize; ++i)
+	{
+		mData[i].~T();
+	}
+	mSize = 0;
+}
+
+template<typename T, uint32_t N>
+void InlineVector<T, N>::reserve(uint32_t capacity)
+{
+	if (capacity > mCapacity)
+	{
+		Grow(capacity);
+	}
+}
+
+template<typename T, uint32_t N>
+T* InlineVector<T, N>::Allocate(uint32_t capacity)
+{
+	T* data = static_cast<T*>(std::malloc(sizeof(T) * capacity));
+	ASSERT(data != nullptr, "[InlineVector] Failed to allocate heap storage.");
+	return data;
+}
+
+template<typename T, uint32_t N>
+void InlineVector<T, N>::Adopt(T* data, uint32_t capacity)
+{
+	for (uint32_t i = 0; i < mSize; ++i)
+	{
+		new(data + i) T(std::move(mData[i]));
+		mData[i].~T();
+	}
+
+	if (!IsInline())
+	{
+		std::free(mData);
+	}
+	mData = data;
+	mCapacity = capacity;
+}
+
+template<typename T, uint32_t N>
+void InlineVector<T, N>::Release()
+{
+	clear();
+	if (!IsInline())
+	{
+		std::free(mData);
+	}
+	mData = InlineData();
+	mCapacity = N;
+}
+
+} // namespace Core
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef INCLUDED_CORE_JOBSYSTEM_H
+#define INCLUDED_CORE_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+
+/*
+Fixed pool of worker threads for fork/join parallelism. Dispatch hands out
+job indices through an atomic counter; the calling thread works on the batch
+too and returns once every job has finished, so a dispatch behaves like a
+parallel for loop. Only one thread may dispatch at a time.
+*/
+class JobSystem
+{
+public:
+	using JobFunc = std::function<void(uint32_t jobIndex)>;
+
+	// 0 workers runs every dispatch inline on the calling thread
+	explicit JobSystem(uint32_t workerCount);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// runs func(0) .. func(count - 1) and waits for all of them
+	void Dispatch(uint32_t count, const JobFunc& func);
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+	// hardware threads minus the one that dispatches
+	static uint32_t GetDefaultWorkerCount();
+
+private:
+	void WorkerLoop();
+	void RunJobs(const JobFunc& func, uint32_t count);
+
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mWake;
+
+	// current batch, guarded by mMutex
+	const JobFunc* mFunc;
+	uint32_t mCount;
+	uint64_t mGeneration;
+	bool bQuit;
+
+	std::atomic<uint32_t> mNext; // next job index to hand out
+	std::atomic<uint32_t> mDone; // jobs finished in the current batch
+	std::atomic<uint32_t> mActive; // workers holding the current batch
+
+}; // class JobSystem
+
+} // namespace Core
+
+#endif // #ifndef INCLUDED_CORE_JOBSYSTEM_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef INCLUDED_CORE_MAPPEDFILE_H
+#define INCLUDED_CORE_MAPPEDFILE_H
+
+#include "Platform.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core
+{
+
+/*
+Read-only view of a whole file mapped into memory. Pages are faulted in by
+the OS as they are touched, so reading a file is a single pass over memory
+with no intermediate copies.
+*/
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const char* fileName);
+	void Close();
+
+	bool IsOpen() const { return mData != nullptr; }
+	const uint8_t* GetData() const { return mData; }
+	size_t GetSize() const { return mSize; }
+
+private:
+	const uint8_t* mData;
+	size_t mSize;
+#if defined(CORE_PLATFORM_WINDOWS)
+	HANDLE mFile;
+	HANDLE mMapping;
+#endif
+}; // class MappedFile
+
+} // namespace Core
+
+#endif // #ifndef INCLUDED_CORE_MAPPEDFILE_H
\ No newline at end of file
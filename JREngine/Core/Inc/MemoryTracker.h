@@ -0,0 +1,122 @@
+#ifndef INCLUDED_CORE_MEMORYTRACKER_H
+#define INCLUDED_CORE_MEMORYTRACKER_H
+
+#include "DeleteUtil.h"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/*
+Opt-in allocation tracking. Define CORE_MEMORY_TRACKING for every project in
+the solution to enable the hooks; otherwise the MEMORY_TRACK_* macros and the
+tagged New/SafeDelete helpers compile down to the plain calls.
+*/
+
+namespace Core
+{
+
+enum class MemoryCategory
+{
+	General,
+	Mesh,
+	Texture,
+	Animation,
+	Physics,
+	AI,
+	GameObject,
+	COUNT
+};
+
+struct MemoryStats
+{
+	size_t currentBytes = 0;
+	size_t peakBytes = 0;
+	size_t budgetBytes = 0; // 0 means no budget
+	uint32_t allocationCount = 0;
+	uint32_t freeCount = 0;
+
+	// allocations made during the last completed frame
+	size_t frameBytes = 0;
+	uint32_t frameAllocations = 0;
+};
+
+class MemoryTracker
+{
+public:
+	static void OnAllocate(MemoryCategory category, size_t bytes);
+	static void OnFree(MemoryCategory category, size_t bytes);
+
+	// bAssert breaks into the debugger instead of only logging when exceeded
+	static void SetBudget(MemoryCategory category, size_t bytes, bool bAssert = false);
+
+	static MemoryStats GetStats(MemoryCategory category);
+	static const char* GetCategoryName(MemoryCategory category);
+
+	// closes the current frame for allocation-rate reporting
+	static void EndFrame();
+
+	static void LogReport();
+	static void LogLeakReport();
+
+	static void Reset();
+
+}; // class MemoryTracker
+
+} // namespace Core
+
+#if defined(CORE_MEMORY_TRACKING)
+	#define MEMORY_TRACK_ALLOC(category, bytes) Core::MemoryTracker::OnAllocate(category, bytes)
+	#define MEMORY_TRACK_FREE(category, bytes) Core::MemoryTracker::OnFree(category, bytes)
+	#define MEMORY_TRACK_END_FRAME() Core::MemoryTracker::EndFrame()
+	#define MEMORY_TRACK_LEAK_REPORT() Core::MemoryTracker::LogLeakReport()
+#else
+	#define MEMORY_TRACK_ALLOC(category, bytes)
+	#define MEMORY_TRACK_FREE(category, bytes)
+	#define MEMORY_TRACK_END_FRAME()
+	#define MEMORY_TRACK_LEAK_REPORT()
+#endif // #if defined(CORE_MEMORY_TRACKING)
+
+// Tagged counterparts of new/SafeDelete. The size is passed back on free so no
+// per-allocation header is needed. Without tracking the tags go unused.
+
+template<typename T, typename... Args>
+inline T* New(Core::MemoryCategory category, Args&&... args)
+{
+	(void)category;
+	MEMORY_TRACK_ALLOC(category, sizeof(T));
+	return new T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+inline T* NewArray(Core::MemoryCategory category, size_t count)
+{
+	(void)category;
+	MEMORY_TRACK_ALLOC(category, sizeof(T) * count);
+	return new T[count];
+}
+
+template<typename T>
+inline void SafeDelete(T*& ptr, Core::MemoryCategory category)
+{
+	(void)category;
+	if (ptr)
+	{
+		MEMORY_TRACK_FREE(category, sizeof(T));
+	}
+	SafeDelete(ptr);
+}
+
+template<typename T>
+inline void SafeDeleteArray(T*& ptr, Core::MemoryCategory category, size_t count)
+{
+	(void)category;
+	(void)count;
+	if (ptr)
+	{
+		MEMORY_TRACK_FREE(category, sizeof(T) * count);
+	}
+	SafeDeleteArray(ptr);
+}
+
+#endif // #ifndef INCLUDED_CORE_MEMORYTRACKER_H
\ No newline at end of file
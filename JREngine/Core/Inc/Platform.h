@@ -0,0 +1,34 @@
+#ifndef INCLUDED_CORE_PLATFORM_H
+#define INCLUDED_CORE_PLATFORM_H
+
+/*
+Platform selection. CORE_PLATFORM_WINDOWS is set for Win32 builds and pulls in
+<Windows.h>; everything else builds against the standard library only.
+
+Define CORE_HEADLESS to compile the engine without a window, GPU or input
+(simulation servers, tools, tests). Rendering entry points then compile to
+no-ops and the Graphics/Input/Audio modules are not required.
+*/
+
+#if defined(_WIN32)
+	#define CORE_PLATFORM_WINDOWS
+#elif defined(__linux__)
+	#define CORE_PLATFORM_LINUX
+#elif defined(__APPLE__)
+	#define CORE_PLATFORM_APPLE
+#endif
+
+#if defined(CORE_PLATFORM_WINDOWS)
+	#include <Windows.h>
+#endif
+
+#if defined(_MSC_VER)
+	#define CORE_DEBUG_BREAK() __debugbreak()
+#elif defined(__GNUC__) || defined(__clang__)
+	#define CORE_DEBUG_BREAK() __builtin_trap()
+#else
+	#include <cstdlib>
+	#define CORE_DEBUG_BREAK() std::abort()
+#endif
+
+#endif // #ifndef INCLUDED_CORE_PLATFORM_H
\ No newline at end of file
@@ -1,5 +1,65 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
+namespace Core
+{
+
+// Packs up to four characters into an int the same way a multi-character
+// literal does on MSVC ('ABCD'), but computed from a string so every compiler
+// produces the same value.
+constexpr int MakeTypeId(const char* name, int value = 0, int count = 0)
+{
+	return (*name == '\0' || count == 4) ? value : MakeTypeId(name + 1, (value << 8) | static_cast<unsigned char>(*name), count + 1);
+}
+
+// Reverse of MakeTypeId, for logs and reports. The id packs up to four
+// characters, first one in the highest byte.
+inline const char* TypeIdToString(int typeId, char (&name)[5])
+{
+	uint32_t length = 0;
+	for (int shift = 24; shift >= 0; shift -= 8)
+	{
+		const char c = static_cast<char>((typeId >> shift) & 0xff);
+		if (c != '\0')
+		{
+			name[length++] = c;
+		}
+	}
+	name[length] = '\0';
+	return name;
+}
+
+/*
+Hands out dense indices (0, 1, 2, ...) to types on first use, one sequence per
+Family. Meant for lookup tables indexed by type, e.g. TypeIndex<Component>.
+Indices depend on first-use order, so they are not stable between runs.
+*/
+template<class Family>
+class TypeIndex
+{
+public:
+	template<class T>
+	static uint32_t Get()
+	{
+		static const uint32_t index = Counter().fetch_add(1);
+		return index;
+	}
+
+	static uint32_t Count() { return Counter().load(); }
+
+private:
+	static std::atomic<uint32_t>& Counter()
+	{
+		static std::atomic<uint32_t> count{ 0 };
+		return count;
+	}
+
+}; // class TypeIndex
+
+} // namespace Core
+
 #define REGISTER_TYPE(TypeId)\
-	static int StaticGetType()	{ return #@TypeId; }\
+	static int StaticGetType()	{ return Core::MakeTypeId(#TypeId); }\
 	virtual int GetType() const { return StaticGetType(); }
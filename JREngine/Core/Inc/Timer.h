@@ -1,6 +1,8 @@
 #ifndef INCLUDED_CORE_TIMER_H
 #define INCLUDED_CORE_TIMER_H
 
+#include <chrono>
+
 namespace Core
 {
 
@@ -17,10 +19,10 @@ public:
 	float GetFramesPerSecond() const;
 
 private:
-	// http://msdn2.microsoft.com/en-us/library/aa383713.aspx
-	LARGE_INTEGER mTicksPerSecond;
-	LARGE_INTEGER mLastTick;
-	LARGE_INTEGER mCurrentTick;
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point mLastTick;
+	Clock::time_point mCurrentTick;
 	
 	float mElapsedTime;
 	float mTotalTime;
@@ -8,7 +8,7 @@ template<typename T>
 class TypedAllocator : private BlockAllocator
 {
 public:
-	TypedAllocator(unsigned int blockCapacity);
+	TypedAllocator(unsigned int blockCapacity, MemoryCategory category = MemoryCategory::General);
 	~TypedAllocator();
 
 	TypedAllocator(const TypedAllocator<T>& copy) = delete;
@@ -17,11 +17,17 @@ public:
 	T* New();
 	void Delete(T* ptr);
 
+	using BlockAllocator::GetCapacity;
+	using BlockAllocator::GetUsedCount;
+	using BlockAllocator::GetPeakUsedCount;
+	using BlockAllocator::GetAllocationCount;
+	using BlockAllocator::GetFailedAllocationCount;
+
 }; // class TypedAllocator : private BlockAllocator
 
 template<typename T>
-TypedAllocator<T>::TypedAllocator(unsigned int blockCapacity)
-	: BlockAllocator(sizeof(T), blockCapacity)
+TypedAllocator<T>::TypedAllocator(unsigned int blockCapacity, MemoryCategory category)
+	: BlockAllocator(sizeof(T), blockCapacity, category)
 {
 } // TypedAllocator(int blockCapacity)
 
@@ -1,6 +1,8 @@
 #ifndef INCLUDED_CORE_WINDOW_H
 #define INCLUDED_CORE_WINDOW_H
 
+#if defined(CORE_PLATFORM_WINDOWS)
+
 namespace Core
 {
 
@@ -25,4 +27,6 @@ namespace Core
 
 } // namespace Core
 
+#endif // #if defined(CORE_PLATFORM_WINDOWS)
+
 #endif // #ifndef INCLUDED_CORE_WINDOW_H
\ No newline at end of file
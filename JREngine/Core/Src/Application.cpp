@@ -1,14 +1,20 @@
 #include "Precompiled.h"
 #include "Application.h"
+#include "MemoryTracker.h"
 
 
 using namespace Core;
 
 
 Core::Application::Application()
+#if defined(CORE_PLATFORM_WINDOWS)
 	: mInstance(nullptr)
 	, mWindow(nullptr)
 	, mRunning(true)
+#else
+	: mRunning(true)
+#endif
+	, mHeadless(false)
 {
 
 }
@@ -18,21 +24,39 @@ Core::Application::~Application()
 
 }
 
+#if defined(CORE_PLATFORM_WINDOWS)
 void Core::Application::Initialize(HINSTANCE instance, LPCSTR appName, uint32_t width, uint32_t height)
 {
 	mInstance = instance;
 	mAppName = appName;
+	mHeadless = false;
 	CoInitialize(nullptr);
 	OnInitialize(width, height);
 }
+#endif // #if defined(CORE_PLATFORM_WINDOWS)
+
+void Core::Application::InitializeHeadless(const char* appName)
+{
+	mAppName = appName;
+	mHeadless = true;
+	OnInitialize(0, 0);
+}
 
 void Core::Application::Terminate()
 {
 	OnTerminate();
 
-	CoUninitialize();
+#if defined(CORE_PLATFORM_WINDOWS)
+	if (!mHeadless)
+	{
+		CoUninitialize();
+	}
+#endif
+
+	MEMORY_TRACK_LEAK_REPORT();
 }
 
+#if defined(CORE_PLATFORM_WINDOWS)
 void Core::Application::HookWindow(HWND hWnd)
 {
 	mWindow = hWnd;
@@ -42,8 +66,11 @@ void Core::Application::UnhookWindow()
 {
 	mWindow = nullptr;
 }
+#endif // #if defined(CORE_PLATFORM_WINDOWS)
 
 void Core::Application::Update()
 {
 	OnUpdate();
+
+	MEMORY_TRACK_END_FRAME();
 }
@@ -5,25 +5,31 @@
 namespace Core
 {
 
-BlockAllocator::BlockAllocator(unsigned int blockSize, unsigned int blockCapacity)
+BlockAllocator::BlockAllocator(unsigned int blockSize, unsigned int blockCapacity, MemoryCategory category)
 	: mSize{ blockSize }
 	, mCapacity{ blockCapacity }
+	, mCategory{ category }
+	, mPeakUsed{ 0 }
+	, mAllocationCount{ 0 }
+	, mFailedCount{ 0 }
 {
 	ASSERT(blockSize > 0 && blockCapacity > 0, "[BlockAllocator] Invalid construction parameters.");
-	// fill free slot indices
+	// fill free slot indices, highest first so blocks are handed out in address order
 	mFreeSlots.reserve(blockCapacity);
-	for (unsigned int i = 0; i < blockCapacity; ++i)
+	for (unsigned int i = blockCapacity; i > 0; --i)
 	{
-		mFreeSlots.push_back(i);
+		mFreeSlots.push_back(i - 1);
 	}
 	// allocate full requested capacity
 	mData = malloc(blockSize*blockCapacity);
+	MEMORY_TRACK_ALLOC(mCategory, blockSize*blockCapacity);
 
 } // BlockAllocator(int blockSize, int blockCapacity)
 
 BlockAllocator::~BlockAllocator()
 {
 	free(mData);
+	MEMORY_TRACK_FREE(mCategory, mSize*mCapacity);
 
 } // ~BlockAllocator()
 
@@ -31,18 +37,22 @@ void* BlockAllocator::Allocate()
 {
 	if (mFreeSlots.size() <= 0)
 	{
+		++mFailedCount;
 		return nullptr;
 	}
 
 	// remove slot from freeslots
-	int offset = mFreeSlots.back();
+	unsigned int slot = mFreeSlots.back();
 	mFreeSlots.pop_back();
 
-	// adjust by block size
-	offset *= mSize;
+	++mAllocationCount;
+	if (GetUsedCount() > mPeakUsed)
+	{
+		mPeakUsed = GetUsedCount();
+	}
 
-	// move ptr to that point
-	void* ptr = static_cast<void*>(static_cast<uint8_t*>(mData) + static_cast<uint8_t>(offset));
+	// move ptr to that block
+	void* ptr = static_cast<void*>(static_cast<uint8_t*>(mData) + (slot * mSize));
 
 	return ptr;
 
@@ -50,9 +60,11 @@ void* BlockAllocator::Allocate()
 
 void BlockAllocator::Free(void* ptr)
 {
-	// TODO: check if ptr is contained in allocator
-	// add pointer block index back into freeslots
-	mFreeSlots.emplace_back(reinterpret_cast<int>(ptr) - reinterpret_cast<int>(mData));
+	const size_t offset = static_cast<uint8_t*>(ptr) - static_cast<uint8_t*>(mData);
+	ASSERT(ptr >= mData && offset < mSize*mCapacity && offset % mSize == 0, "[BlockAllocator] Pointer does not belong to this allocator.");
+
+	// add block index back into freeslots
+	mFreeSlots.push_back(static_cast<unsigned int>(offset / mSize));
 
 } // void Free(void* ptr)
 
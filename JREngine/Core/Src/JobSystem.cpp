@@ -0,0 +1,128 @@
+#include "Precompiled.h"
+
+#include "JobSystem.h"
+
+using namespace Core;
+
+JobSystem::JobSystem(uint32_t workerCount)
+	: mFunc(nullptr)
+	, mCount(0)
+	, mGeneration(0)
+	, bQuit(false)
+	, mNext{ 0 }
+	, mDone{ 0 }
+	, mActive{ 0 }
+{
+	mWorkers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		mWorkers.emplace_back(&JobSystem::WorkerLoop, this);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		bQuit = true;
+	}
+	mWake.notify_all();
+
+	for (auto& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::Dispatch(uint32_t count, const JobFunc& func)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	if (mWorkers.empty() || count == 1)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFunc = &func;
+		mCount = count;
+		mNext.store(0, std::memory_order_relaxed);
+		mDone.store(0, std::memory_order_relaxed);
+		++mGeneration;
+	}
+	mWake.notify_all();
+
+	RunJobs(func, count);
+	while (mDone.load(std::memory_order_acquire) < count)
+	{
+		std::this_thread::yield();
+	}
+
+	// retire the batch, workers that wake from now on find nothing to do
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFunc = nullptr;
+		mCount = 0;
+	}
+	// late workers may still be reading the counters, wait before they are reset
+	while (mActive.load(std::memory_order_acquire) != 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount()
+{
+	const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void JobSystem::WorkerLoop()
+{
+	uint64_t generation = 0;
+	for (;;)
+	{
+		const JobFunc* func = nullptr;
+		uint32_t count = 0;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWake.wait(lock, [this, generation]() { return bQuit || mGeneration != generation; });
+			if (bQuit)
+			{
+				return;
+			}
+			generation = mGeneration;
+			if (mFunc == nullptr)
+			{
+				continue;
+			}
+			func = mFunc;
+			count = mCount;
+			mActive.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		RunJobs(*func, count);
+		mActive.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void JobSystem::RunJobs(const JobFunc& func, uint32_t count)
+{
+	for (;;)
+	{
+		const uint32_t index = mNext.fetch_add(1, std::memory_order_relaxed);
+		if (index >= count)
+		{
+			return;
+		}
+		func(index);
+		mDone.fetch_add(1, std::memory_order_release);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "Precompiled.h"
+#include "MemoryTracker.h"
+
+#include "Debug.h"
+
+using namespace Core;
+
+namespace
+{
+
+struct CategoryCounters
+{
+	std::atomic<size_t> currentBytes{ 0 };
+	std::atomic<size_t> peakBytes{ 0 };
+	std::atomic<uint32_t> allocationCount{ 0 };
+	std::atomic<uint32_t> freeCount{ 0 };
+
+	// running totals, sampled at the end of every frame
+	std::atomic<size_t> totalBytes{ 0 };
+	size_t lastFrameTotalBytes = 0; // only touched by EndFrame
+	uint32_t lastFrameAllocationCount = 0;
+	std::atomic<size_t> frameBytes{ 0 };
+	std::atomic<uint32_t> frameAllocations{ 0 };
+
+	// read by every allocating thread, job workers included
+	std::atomic<size_t> budgetBytes{ 0 };
+	std::atomic<bool> bAssertOnBudget{ false };
+	std::atomic<bool> bBudgetReported{ false };
+};
+
+const uint32_t kCategoryCount = static_cast<uint32_t>(MemoryCategory::COUNT);
+CategoryCounters sCounters[kCategoryCount];
+
+const char* const kCategoryNames[kCategoryCount] =
+{
+	"General",
+	"Mesh",
+	"Texture",
+	"Animation",
+	"Physics",
+	"AI",
+	"GameObject"
+};
+
+CategoryCounters& GetCounters(MemoryCategory category)
+{
+	ASSERT(category < MemoryCategory::COUNT, "[MemoryTracker] Invalid category.");
+	return sCounters[static_cast<uint32_t>(category)];
+}
+
+} // namespace
+
+void MemoryTracker::OnAllocate(MemoryCategory category, size_t bytes)
+{
+	CategoryCounters& counters = GetCounters(category);
+
+	const size_t current = counters.currentBytes.fetch_add(bytes) + bytes;
+	counters.totalBytes.fetch_add(bytes);
+	counters.allocationCount.fetch_add(1);
+
+	size_t peak = counters.peakBytes.load();
+	while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current)) {}
+
+	const size_t budget = counters.budgetBytes.load();
+	bool bReported = false;
+	// report once per crossing, re-armed when usage drops below budget; the
+	// exchange lets only one of several threads crossing together report it
+	if (budget != 0 && current > budget && counters.bBudgetReported.compare_exchange_strong(bReported, true))
+	{
+		LOGPRINTF("[MemoryTracker] %s budget exceeded: %zu / %zu bytes.\n", GetCategoryName(category), current, budget);
+		ASSERT(!counters.bAssertOnBudget.load(), "[MemoryTracker] Memory budget exceeded.");
+	}
+}
+
+void MemoryTracker::OnFree(MemoryCategory category, size_t bytes)
+{
+	CategoryCounters& counters = GetCounters(category);
+
+	const size_t previous = counters.currentBytes.fetch_sub(bytes);
+	ASSERT(previous >= bytes, "[MemoryTracker] Freed more memory than was allocated.");
+	counters.freeCount.fetch_add(1);
+
+	if (counters.bBudgetReported.load() && previous - bytes <= counters.budgetBytes.load())
+	{
+		counters.bBudgetReported.store(false);
+	}
+}
+
+void MemoryTracker::SetBudget(MemoryCategory category, size_t bytes, bool bAssert)
+{
+	CategoryCounters& counters = GetCounters(category);
+	counters.budgetBytes = bytes;
+	counters.bAssertOnBudget = bAssert;
+	counters.bBudgetReported = false;
+}
+
+MemoryStats MemoryTracker::GetStats(MemoryCategory category)
+{
+	const CategoryCounters& counters = GetCounters(category);
+
+	MemoryStats stats;
+	stats.currentBytes = counters.currentBytes.load();
+	stats.peakBytes = counters.peakBytes.load();
+	stats.budgetBytes = counters.budgetBytes.load();
+	stats.allocationCount = counters.allocationCount.load();
+	stats.freeCount = counters.freeCount.load();
+	stats.frameBytes = counters.frameBytes.load();
+	stats.frameAllocations = counters.frameAllocations.load();
+	return stats;
+}
+
+const char* MemoryTracker::GetCategoryName(MemoryCategory category)
+{
+	return category < MemoryCategory::COUNT ? kCategoryNames[static_cast<uint32_t>(category)] : "Unknown";
+}
+
+void MemoryTracker::EndFrame()
+{
+	for (auto& counters : sCounters)
+	{
+		const size_t totalBytes = counters.totalBytes.load();
+		const uint32_t allocationCount = counters.allocationCount.load();
+
+		counters.frameBytes = totalBytes - counters.lastFrameTotalBytes;
+		counters.frameAllocations = allocationCount - counters.lastFrameAllocationCount;
+
+		counters.lastFrameTotalBytes = totalBytes;
+		counters.lastFrameAllocationCount = allocationCount;
+	}
+}
+
+void MemoryTracker::LogReport()
+{
+	LOGPRINTF("[MemoryTracker] %-12s %12s %12s %12s %8s %10s\n", "Category", "Current", "Peak", "Budget", "Allocs", "Frame");
+	for (uint32_t i = 0; i < kCategoryCount; ++i)
+	{
+		const MemoryStats stats = GetStats(static_cast<MemoryCategory>(i));
+		LOGPRINTF("[MemoryTracker] %-12s %12zu %12zu %12zu %8u %10zu\n",
+			kCategoryNames[i],
+			stats.currentBytes,
+			stats.peakBytes,
+			stats.budgetBytes,
+			stats.allocationCount,
+			stats.frameBytes);
+	}
+}
+
+void MemoryTracker::LogLeakReport()
+{
+	bool bLeaked = false;
+	for (uint32_t i = 0; i < kCategoryCount; ++i)
+	{
+		const MemoryStats stats = GetStats(static_cast<MemoryCategory>(i));
+		if (stats.currentBytes != 0)
+		{
+			bLeaked = true;
+			LOGPRINTF("[MemoryTracker] Leak: %s still holds %zu bytes (%u allocations, %u frees).\n",
+				kCategoryNames[i],
+				stats.currentBytes,
+				stats.allocationCount,
+				stats.freeCount);
+		}
+	}
+	if (!bLeaked)
+	{
+		LOGPRINTF("[MemoryTracker] No leaks detected.\n");
+	}
+}
+
+void MemoryTracker::Reset()
+{
+	for (auto& counters : sCounters)
+	{
+		counters.currentBytes = 0;
+		counters.peakBytes = 0;
+		counters.allocationCount = 0;
+		counters.freeCount = 0;
+		counters.totalBytes = 0;
+		counters.lastFrameTotalBytes = 0;
+		counters.lastFrameAllocationCount = 0;
+		counters.frameBytes = 0;
+		counters.frameAllocations = 0;
+		counters.budgetBytes = 0;
+		counters.bAssertOnBudget = false;
+		counters.bBudgetReported = false;
+	}
+}
\ No newline at end of file
@@ -11,16 +11,12 @@ Timer::Timer()
 	, mFrameSinceLastSecond(0.0f)
 	, mFramesPerSecond(0.0f)
 {
-	mTicksPerSecond.QuadPart = 0;
-	mLastTick.QuadPart = 0;
-	mCurrentTick.QuadPart = 0;
 }
 
 void Timer::Initialize()
 {
-	// Get the system clock frequency and current tick
-	QueryPerformanceFrequency(&mTicksPerSecond);
-	QueryPerformanceCounter(&mCurrentTick);
+	// Get the current tick
+	mCurrentTick = Clock::now();
 
 	mLastTick = mCurrentTick;
 	
@@ -35,10 +31,10 @@ void Timer::Initialize()
 void Timer::Update()
 {
 	// Get the current tick count
-	QueryPerformanceCounter(&mCurrentTick);
+	mCurrentTick = Clock::now();
 
 	// Calculate the total time and elapsed time
-	mElapsedTime = static_cast<float>(mCurrentTick.QuadPart - mLastTick.QuadPart) / mTicksPerSecond.QuadPart;
+	mElapsedTime = std::chrono::duration<float>(mCurrentTick - mLastTick).count();
 	mTotalTime += mElapsedTime;
 
 	// Update the last tick count
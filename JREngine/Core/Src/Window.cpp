@@ -4,6 +4,8 @@
 
 #include "Debug.h"
 
+#if defined(CORE_PLATFORM_WINDOWS)
+
 using namespace Core;
 
 LRESULT CALLBACK WinProc(HWND handle, UINT message, WPARAM wParam, LPARAM lParam)
@@ -117,4 +119,6 @@ bool Window::ProcessMessage()
 	}
 
 	return (WM_QUIT == msg.message);
-}
\ No newline at end of file
+}
+
+#endif // #if defined(CORE_PLATFORM_WINDOWS)
\ No newline at end of file
@@ -61,4 +61,372 @@ public:
 	}
 };
 
+TEST_CLASS(InlineVectorTest)
+{
+public:
+
+	TEST_METHOD(TestPushInline)
+	{
+		Core::InlineVector<int, 4> vec;
+		for (int i = 0; i < 4; ++i)
+		{
+			vec.push_back(i);
+		}
+		Assert::AreEqual(4u, vec.size());
+		Assert::IsTrue(vec.IsInline());
+		Assert::AreEqual(3, vec.back());
+	}
+
+	TEST_METHOD(TestSpillToHeap)
+	{
+		Core::InlineVector<int, 2> vec;
+		for (int i = 0; i < 10; ++i)
+		{
+			vec.push_back(i);
+		}
+		Assert::IsFalse(vec.IsInline());
+		Assert::AreEqual(10u, vec.size());
+
+		int sum = 0;
+		for (auto i : vec)
+		{
+			sum += i;
+		}
+		Assert::AreEqual(45, sum);
+	}
+
+	TEST_METHOD(TestErase)
+	{
+		Core::InlineVector<int, 4> vec{ 0, 1, 2, 3 };
+		vec.erase(vec.begin() + 1);
+		Assert::AreEqual(3u, vec.size());
+		Assert::AreEqual(2, vec[1]);
+	}
+
+	TEST_METHOD(TestMove)
+	{
+		Core::InlineVector<std::unique_ptr<int>, 2> vec;
+		vec.emplace_back(std::make_unique<int>(7));
+
+		Core::InlineVector<std::unique_ptr<int>, 2> moved(std::move(vec));
+		Assert::IsTrue(vec.empty());
+		Assert::AreEqual(7, *moved[0]);
+	}
+
+	TEST_METHOD(TestPushOwnElementWhileFull)
+	{
+		Core::InlineVector<std::string, 2> vec{ "first", "second" };
+		vec.push_back(vec[0]);
+		Assert::IsFalse(vec.IsInline());
+		Assert::AreEqual(std::string("first"), vec[2]);
+	}
+
+	TEST_METHOD(TestFixedVector)
+	{
+		Core::FixedVector<int, 3> vec{ 1, 2 };
+		vec.push_back(3);
+		Assert::IsTrue(vec.full());
+		vec.pop_back();
+		Assert::AreEqual(2u, vec.size());
+	}
+};
+
+TEST_CLASS(ConcurrentQueueTest)
+{
+public:
+
+	TEST_METHOD(TestSpscCapacity)
+	{
+		Core::SpscQueue<int> queue(3);
+		Assert::AreEqual(4u, queue.Capacity());
+
+		for (int i = 0; i < 4; ++i)
+		{
+			Assert::IsTrue(queue.TryPush(i));
+		}
+		Assert::IsFalse(queue.TryPush(4));
+
+		int value = -1;
+		Assert::IsTrue(queue.TryPop(value));
+		Assert::AreEqual(0, value);
+	}
+
+	TEST_METHOD(TestSpscBatch)
+	{
+		Core::SpscQueue<int> queue(8);
+		int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Assert::AreEqual(8u, queue.PushBatch(in, 10));
+
+		int out[10] = {};
+		Assert::AreEqual(8u, queue.PopBatch(out, 10));
+		Assert::AreEqual(7, out[7]);
+		Assert::IsTrue(queue.IsEmpty());
+	}
+
+	TEST_METHOD(TestMpmcBatch)
+	{
+		Core::MpmcQueue<int> queue(8);
+		int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Assert::AreEqual(6u, queue.PushBatch(in, 6));
+		Assert::AreEqual(2u, queue.PushBatch(in + 6, 4));
+		Assert::IsFalse(queue.TryPush(8));
+
+		int out[10] = {};
+		Assert::AreEqual(3u, queue.PopBatch(out, 3));
+		Assert::AreEqual(5u, queue.PopBatch(out + 3, 10));
+		Assert::AreEqual(7, out[7]);
+		Assert::AreEqual(0u, queue.PopBatch(out, 10));
+	}
+
+	TEST_METHOD(TestMpmcThreaded)
+	{
+		const int kProducers = 4;
+		const int kItems = 10000;
+		Core::MpmcQueue<int> queue(256);
+
+		std::vector<std::thread> producers;
+		for (int p = 0; p < kProducers; ++p)
+		{
+			producers.emplace_back([&queue]()
+			{
+				for (int i = 1; i <= kItems; ++i)
+				{
+					while (!queue.TryPush(i)) {}
+				}
+			});
+		}
+
+		long long sum = 0;
+		int received = 0;
+		int value = 0;
+		while (received < kProducers * kItems)
+		{
+			if (queue.TryPop(value))
+			{
+				sum += value;
+				++received;
+			}
+		}
+		for (auto& producer : producers)
+		{
+			producer.join();
+		}
+		Assert::AreEqual(static_cast<long long>(kProducers) * kItems * (kItems + 1) / 2, sum);
+	}
+
+	//---------Benchmarks---------
+
+	TEST_METHOD(BenchmarkSpscThroughput)
+	{
+		const int kItems = 1000000;
+		Core::SpscQueue<int> queue(1024);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		std::thread producer([&queue]()
+		{
+			int batch[32];
+			for (int i = 0; i < kItems; i += 32)
+			{
+				for (int j = 0; j < 32; ++j)
+				{
+					batch[j] = i + j;
+				}
+				uint32_t pushed = 0;
+				while (pushed < 32)
+				{
+					pushed += queue.PushBatch(batch + pushed, 32 - pushed);
+				}
+			}
+		});
+
+		int batch[32];
+		int received = 0;
+		while (received < kItems)
+		{
+			received += queue.PopBatch(batch, 32);
+		}
+		producer.join();
+		auto end = std::chrono::high_resolution_clock::now();
+
+		char buffer[128];
+		sprintf_s(buffer, "[SpscQueue] %d items in %.2f ms\n", received,
+			std::chrono::duration<double, std::milli>(end - start).count());
+		Logger::WriteMessage(buffer);
+	}
+
+	TEST_METHOD(BenchmarkMpmcThroughput)
+	{
+		const int kThreads = 4;
+		const int kItems = 250000;
+		Core::MpmcQueue<int> queue(1024);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<std::thread> threads;
+		for (int t = 0; t < kThreads; ++t)
+		{
+			threads.emplace_back([&queue]()
+			{
+				for (int i = 0; i < kItems; ++i)
+				{
+					while (!queue.TryPush(i)) {}
+				}
+			});
+		}
+
+		int received = 0;
+		int value = 0;
+		while (received < kThreads * kItems)
+		{
+			if (queue.TryPop(value))
+			{
+				++received;
+			}
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		char buffer[128];
+		sprintf_s(buffer, "[MpmcQueue] %d items in %.2f ms\n", received,
+			std::chrono::duration<double, std::milli>(end - start).count());
+		Logger::WriteMessage(buffer);
+	}
+};
+
+TEST_CLASS(RTTITest)
+{
+	struct FamilyA {};
+	struct FamilyB {};
+	struct TypeX {};
+	struct TypeY {};
+
+public:
+
+	TEST_METHOD(TestMakeTypeId)
+	{
+		// matches the MSVC value of the multi-character literal 'ABCD'
+		Assert::AreEqual(0x41424344, Core::MakeTypeId("ABCD"));
+		Assert::AreEqual(0x41, Core::MakeTypeId("A"));
+		Assert::AreEqual(Core::MakeTypeId("ABCD"), Core::MakeTypeId("ABCDE"));
+	}
+
+	TEST_METHOD(TestTypeIdToString)
+	{
+		char name[5];
+		Assert::AreEqual("ABCD", Core::TypeIdToString(Core::MakeTypeId("ABCD"), name));
+		Assert::AreEqual("AB", Core::TypeIdToString(Core::MakeTypeId("AB"), name));
+		Assert::AreEqual("", Core::TypeIdToString(0, name));
+	}
+
+	TEST_METHOD(TestTypeIndexDense)
+	{
+		const uint32_t x = Core::TypeIndex<FamilyA>::Get<TypeX>();
+		const uint32_t y = Core::TypeIndex<FamilyA>::Get<TypeY>();
+		Assert::AreNotEqual(x, y);
+		Assert::IsTrue(x < 2u && y < 2u);
+		Assert::AreEqual(x, Core::TypeIndex<FamilyA>::Get<TypeX>());
+		Assert::AreEqual(2u, Core::TypeIndex<FamilyA>::Count());
+
+		// every family counts from zero
+		Assert::AreEqual(0u, Core::TypeIndex<FamilyB>::Get<TypeY>());
+	}
+};
+
+TEST_CLASS(JobSystemTest)
+{
+public:
+
+	TEST_METHOD(TestDispatchRunsEveryJobOnce)
+	{
+		Core::JobSystem jobSystem(3);
+		std::vector<std::atomic<int>> counts(1000);
+		for (int round = 0; round < 50; ++round)
+		{
+			jobSystem.Dispatch(1000, [&counts](uint32_t index)
+			{
+				counts[index].fetch_add(1);
+			});
+		}
+		for (auto& count : counts)
+		{
+			Assert::AreEqual(50, count.load());
+		}
+	}
+
+	TEST_METHOD(TestDispatchInline)
+	{
+		Core::JobSystem jobSystem(0);
+		const std::thread::id caller = std::this_thread::get_id();
+		int sum = 0;
+		jobSystem.Dispatch(10, [&sum, caller](uint32_t index)
+		{
+			Assert::IsTrue(std::this_thread::get_id() == caller);
+			sum += index;
+		});
+		Assert::AreEqual(45, sum);
+	}
+};
+
+TEST_CLASS(HandlePoolTest)
+{
+	struct Item { int value; };
+
+public:
+
+	TEST_METHOD(TestRestore)
+	{
+		Core::HandlePool<Item> pool(4);
+		Item a{ 1 }, b{ 2 };
+		auto handleA = pool.Register(&a);
+		const uint32_t id = handleA.GetId();
+		Assert::IsTrue(Core::Handle<Item>::FromId(id) == handleA);
+
+		// restoring a live handle fails
+		Assert::IsFalse(pool.Restore(handleA, &b));
+
+		pool.Unregister(handleA);
+		Assert::IsFalse(handleA.IsValid());
+		Assert::IsTrue(pool.Restore(handleA, &b));
+		Assert::IsTrue(handleA.IsValid());
+		Assert::AreEqual(2, handleA->value);
+
+		// the slot left the free list, new handles go elsewhere
+		auto handleC = pool.Register(&a);
+		Assert::IsTrue(handleC != handleA);
+		pool.Unregister(handleA);
+		pool.Unregister(handleC);
+	}
+
+	TEST_METHOD(TestRestoreAfterReuse)
+	{
+		Core::HandlePool<Item> pool(4);
+		Item a{ 1 }, b{ 2 };
+		auto handleA = pool.Register(&a);
+		pool.Unregister(handleA);
+		auto handleB = pool.Register(&b);
+		pool.Unregister(handleB);
+
+		// the slot moved on to b in between, b's handles must stay dead
+		Assert::IsTrue(pool.Restore(handleA, &a));
+		Assert::IsTrue(handleA.IsValid());
+		Assert::IsFalse(handleB.IsValid());
+		pool.Unregister(handleA);
+
+		// and its generation is not handed out again
+		auto handleC = pool.Register(&a);
+		Assert::IsTrue(handleC != handleA && handleC != handleB);
+		Assert::IsFalse(handleB.IsValid());
+		pool.Unregister(handleC);
+	}
+
+	TEST_METHOD(TestForeignId)
+	{
+		Core::HandlePool<Item> pool(4);
+		Assert::IsFalse(Core::Handle<Item>::FromId(0x01000100).IsValid());
+		Assert::IsTrue(Core::Handle<Item>::FromId(0x01000100).Get() == nullptr);
+	}
+};
+
 }
\ No newline at end of file
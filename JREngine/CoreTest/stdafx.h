@@ -11,4 +11,16 @@
 #include "CppUnitTest.h"
 
 // TODO: reference additional headers your program requires here
-#include <Core\Inc\BitMask.h>
\ No newline at end of file
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Core\Inc\BitMask.h>
+#include <Core\Inc\ConcurrentQueue.h>
+#include <Core\Inc\FixedVector.h>
+#include <Core\Inc\HandlePool.h>
+#include <Core\Inc\InlineVector.h>
+#include <Core\Inc\JobSystem.h>
+#include <Core\Inc\RTTI.h>
\ No newline at end of file
@@ -9,17 +9,26 @@ class TransformComponent;
 
 class AABoxColliderComponent : public Component
 {
+	friend class CollisionService;
+	friend class QueryService;
+	static const uint32_t kNoProxy = 0xffffffff;
+
 	const TransformComponent* mTransformComponent;
 	Math::Vector3 mCenter;
 	Math::Vector3 mExtend;
 	Math::Vector4 mColor;
 
 	using CollisionEvent = std::function<void()>;
-	using CollisionEvents = std::vector<CollisionEvent>;
+	using CollisionEvents = Core::InlineVector<CollisionEvent, 2>;
 	CollisionEvents mCollisionEvents;
 	CollisionEvents mCollisionEnterEvents;
 	CollisionEvents mCollisionExitEvents;
 
+	uint32_t mBroadphaseIndex; // slot in the CollisionService proxy array
+	int32_t mQueryProxy; // leaf in the QueryService tree
+	uint32_t mQueryIndex; // slot in the QueryService collider list
+	bool bColliding; // overlapped anything during the last collision update
+
 public:
 	enum class CollisionEventType
 	{
@@ -31,7 +40,18 @@ public:
 
 	REGISTER_TYPE(ABCC); // (A)ABB(B)ox(C)ollider(C)omponent
 
+	// fixed layout stored in cooked templates
+	struct Record
+	{
+		float center[3] = { 0.0f, 0.0f, 0.0f };
+		float extend[3] = { 1.0f, 1.0f, 1.0f };
+		float color[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+	};
+
 	static void CreateFunc(GameObject* gameObj, const TiXmlNode* node);
+	static void CloneFunc(GameObject* gameObj, const Component* source);
+	static void CookFunc(const TiXmlNode* node, Record& record);
+	static void LoadFunc(GameObject* gameObj, const void* data, uint32_t size);
 
 	AABoxColliderComponent();
 	~AABoxColliderComponent() override;
@@ -39,25 +59,28 @@ public:
 	void Initialize() override;
 	void Terminate() override;
 
-	void Render() override;
+	void Extract(RenderList& list) const override;
+	bool GetBounds(Math::AABB& aabb) const override { aabb = GetAABB(); return true; }
+
+	// box, color and whether it was colliding
+	uint32_t GetSnapshotVersion() const override { return 1; }
+	void Serialize(SnapshotWriter& writer) const override;
+	void Deserialize(SnapshotReader& reader, uint32_t version) override;
 
 	bool CheckCollision(AABoxColliderComponent& boxB);
 	void AddCollisionEvent(CollisionEvent eventCall, CollisionEventType eventType = CollisionEventType::Colliding);
 	void OnCollision();
 	void OnCollisionEnter();
 	void OnCollisionExit();
+	bool HasEvents(CollisionEventType eventType) const;
 
 	void SetCenter(const Math::Vector3& center) { mCenter = center; }
 	void SetExtend(const Math::Vector3& extend) { mExtend = extend; }
 	void SetColor(const Math::Vector4& color) { mColor = color; }
 
 	Math::AABB GetAABB() const;
+	bool IsColliding() const { return bColliding; }
 
 };
 
-static bool CheckCollision(AABoxColliderComponent* boxA, AABoxColliderComponent* boxB)
-{
-	return boxA->CheckCollision(*boxB);
-}
-
 } // namespace GameEngine
\ No newline at end of file
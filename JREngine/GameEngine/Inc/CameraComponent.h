@@ -1,7 +1,9 @@
 #pragma once
 
+#if !defined(CORE_HEADLESS)
+
 #include "Component.h"
-#include "Graphics\Inc\Camera.h"
+#include "Graphics/Inc/Camera.h"
 
 namespace GameEngine
 {
@@ -24,6 +26,9 @@ public:
 	REGISTER_TYPE(CAMC); // (Cam)era(C)omponent
 
 	static void CreateFunc(GameObject* gameObj, const TiXmlNode* node);
+	static void CloneFunc(GameObject* gameObj, const Component* source);
+	// takes no parameters, the cooked record is empty
+	static void LoadFunc(GameObject* gameObj, const void* data, uint32_t size);
 
 	CameraComponent();
 	~CameraComponent() override;
@@ -33,4 +38,6 @@ public:
 
 };
 
-} // namespace GameEngine
\ No newline at end of file
+} // namespace GameEngine
+
+#endif // #if !defined(CORE_HEADLESS)
\ No newline at end of file
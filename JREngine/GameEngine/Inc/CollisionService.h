@@ -1,8 +1,10 @@
 #pragma once
 
+#include "MessageBus.h"
+#include "PairCache.h"
 #include "Service.h"
 
-#include <Core\Inc\RTTI.h>
+#include <Core/Inc/RTTI.h>
 
 namespace GameEngine
 {
@@ -10,13 +12,55 @@ namespace GameEngine
 class World;
 class AABoxColliderComponent;
 
+// sent through the World's MessageBus to both objects of a new contact
+struct CollisionEnterMessage
+{
+	REGISTER_MESSAGE(CLEN)
+	GameObjectHandle other;
+};
+
+// sent to each object of a pair that separated, if it still exists
+struct CollisionExitMessage
+{
+	REGISTER_MESSAGE(CLEX)
+	GameObjectHandle other;
+};
+
+/*
+Sort-and-sweep broadphase. Collider bounds are kept in a proxy array sorted by
+min x that persists between frames, so the per-frame re-sort is an insertion
+sort over an almost sorted array. The sweep then only tests neighbours whose x
+ranges overlap and reports each overlapping pair once.
+
+Overlapping pairs are remembered in a PairCache. Diffing it against the
+current frame gives Enter and Exit events; all events are collected first and
+dispatched in batches once the sweep is done. Enter and Exit also go out as
+messages on the World's MessageBus for listeners without a collider callback.
+*/
 class CollisionService : public Service
 {
-	using Subscribers = std::vector<AABoxColliderComponent*>;
-	Subscribers mSubscribers;
+	struct Proxy
+	{
+		float minX, maxX;
+		float minY, maxY;
+		float minZ, maxZ;
+		AABoxColliderComponent* collider; // nullptr once unregistered
+	};
+	using Proxies = std::vector<Proxy>;
+	using Colliders = std::vector<AABoxColliderComponent*>;
+
+	Proxies mProxies;
+	PairCache mPairCache;
+	Colliders mEnterEvents;
+	Colliders mCollidingEvents;
+	Colliders mExitEvents;
+	uint32_t mFrame;
+	uint32_t mRemovedCount;
+	uint32_t mAddedCount; // registered since the last sort, still unsorted
+	uint32_t mPairCount;
 
 public:
-	REGISTER_TYPE(BSES) // (B)a(seS)ervice
+	REGISTER_TYPE(CLSV) // (C)o(L)lision(S)er(V)ice
 
 	CollisionService();
 	~CollisionService() override;
@@ -32,6 +76,18 @@ public:
 	void Register(AABoxColliderComponent* component);
 	void Unregister(AABoxColliderComponent* component);
 
+	uint32_t GetColliderCount() const { return static_cast<uint32_t>(mProxies.size()) - mRemovedCount; }
+	// overlapping pairs found by the last update
+	uint32_t GetPairCount() const { return mPairCount; }
+
+private:
+	void RemoveUnregistered();
+	void UpdateBounds();
+	void SortProxies();
+	void FindPairs();
+	void FindExits();
+	void DispatchEvents();
+
 }; // class CollisionService
 
 } // namespace GameEngine
\ No newline at end of file
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <AudioFMOD\Inc\Audio.h>
-#include <Core\Inc\Core.h>
-#include <Graphics\Inc\Graphics.h>
-#include <Math\Inc\EngineMath.h>
-#include <Physics\Inc\Physics.h>
+#include <Core/Inc/Core.h>
+#include <Math/Inc/EngineMath.h>
+#include <Physics/Inc/Physics.h>
 
-#include <TinyXML\Inc\tinyxml.h>
+#if !defined(CORE_HEADLESS)
+#include <AudioFMOD/Inc/Audio.h>
+#include <Graphics/Inc/Graphics.h>
+#endif
+
+#include <TinyXML/Inc/tinyxml.h>
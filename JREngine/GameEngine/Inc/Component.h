@@ -1,22 +1,47 @@
 #pragma once
 
-#include <Core\Inc\RTTI.h>
+#include <Core/Inc/RTTI.h>
+
+namespace Math
+{
+struct AABB;
+}
 
 namespace GameEngine
 {
 
 class GameObject;
+struct RenderList;
+class SnapshotReader;
+class SnapshotWriter;
 
 class Component
 {
 protected:
 	friend class GameObject;
+	friend class TickScheduler;
+	static const uint32_t kNoTickList = 0xffffffff;
+
 	GameObject* mGameObject;
 
+private:
+	float mTickTime; // accumulated since the last Update
+	uint16_t mTickInterval;
+	uint16_t mTickStagger;
+	uint32_t mTickListIndex; // slot in the TickScheduler distance list
+	bool bAsleep;
+
 public:
 	REGISTER_TYPE(BSEC) // (B)a(seC)omponent
 
-	Component() : mGameObject{ nullptr } {}
+	Component()
+		: mGameObject{ nullptr }
+		, mTickTime{ 0.0f }
+		, mTickInterval{ 1 }
+		, mTickStagger{ 0 }
+		, mTickListIndex{ kNoTickList }
+		, bAsleep{ false }
+	{}
 	virtual ~Component() {}
 
 	Component(const Component&) = delete;
@@ -26,12 +51,56 @@ public:
 	virtual void Terminate() {}
 
 	virtual void Update(float dTime) {}
-	virtual void Render() {}
+	// Adds what this component draws to the frame's render packet. Runs on
+	// worker threads alongside other objects' components, so only read this
+	// component's own object.
+	virtual void Extract(RenderList& list) const {}
+	// World space box around what Extract draws, read by the VisibilityService
+	// to cull the object. Objects none of whose components report bounds are
+	// never culled.
+	virtual bool GetBounds(Math::AABB& aabb) const { return false; }
 	virtual void Render2D() {}
 
+	// WorldSnapshot hooks. Serialize writes the runtime state, Deserialize
+	// reads it back into this component; version is the GetSnapshotVersion
+	// the data was written with, bump it when the layout changes.
+	virtual uint32_t GetSnapshotVersion() const { return 0; }
+	virtual void Serialize(SnapshotWriter& writer) const {}
+	virtual void Deserialize(SnapshotReader& reader, uint32_t version) {}
+
 	GameObject& GetOwner() { return *mGameObject; }
 	const GameObject& GetOwner() const { return *mGameObject; }
 
+	// Update runs every interval frames (1 is every frame) and gets the time
+	// since it last ran. Components on the same interval are spread evenly
+	// over its frames so their updates do not all land on one frame.
+	void SetTickInterval(uint32_t interval);
+	uint32_t GetTickInterval() const { return mTickInterval; }
+	// takes the interval from the World's TickScheduler distance bands
+	// instead, for components of objects already in a World
+	void SetTickByDistance(bool byDistance);
+	bool IsTickByDistance() const { return mTickListIndex != kNoTickList; }
+
+	// no Update until woken, by Wake or by a new collision of the object;
+	// time keeps accumulating, the first Update after waking gets all of it
+	void Sleep() { bAsleep = true; }
+	void Wake() { bAsleep = false; }
+	bool IsAsleep() const { return bAsleep; }
+
+	// used by the update passes, true when Update is due this frame with
+	// tickTime set to the time accumulated for it
+	bool ConsumeTick(uint32_t frame, float dTime, float& tickTime)
+	{
+		mTickTime += dTime;
+		if (bAsleep || (mTickInterval > 1 && (frame + mTickStagger) % mTickInterval != 0))
+		{
+			return false;
+		}
+		tickTime = mTickTime;
+		mTickTime = 0.0f;
+		return true;
+	}
+
 }; // class Component
 
 } // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "Component.h"
+#include "TickScheduler.h"
+#include "UpdateDesc.h"
+#include "WorldProfiler.h"
+
+namespace GameEngine
+{
+
+/*
+Paged storage for every component of one type. Slots never move, so component
+pointers stay valid, and a full pool grows by another page instead of falling
+back to the heap. Freed slots are reused first, so spawn and despawn churn
+does not allocate once the pool has warmed up.
+
+A pool can also own the type's update: once scheduled (see
+World::RegisterComponentPool) the pass walks the slots in memory order
+calling the concrete T::Update without a virtual dispatch, skipping
+components whose tick is not due (Component::ConsumeTick). Unscheduled pools
+are storage only and their components update with their object.
+*/
+class ComponentPoolBase
+{
+public:
+	virtual ~ComponentPoolBase() {}
+
+	virtual void Free(Component* component, uint32_t slot) = 0;
+	// inactive components stay allocated but are skipped by Update
+	virtual void SetActive(uint32_t slot, bool active) = 0;
+	// grows the pool to hold at least capacity components
+	virtual void Reserve(uint32_t capacity) = 0;
+	virtual void Update(float dTime) = 0;
+	// updates the slots in [begin, end), lets the World split a pass across threads
+	virtual void Update(float dTime, uint32_t begin, uint32_t end) = 0;
+
+	virtual uint32_t GetCount() const = 0;
+	virtual uint32_t GetCapacity() const = 0;
+	// one past the highest slot in use
+	virtual uint32_t GetSlotCount() const = 0;
+
+	void SetUpdateDesc(const UpdateDesc& desc) { mUpdateDesc = desc; bScheduled = true; }
+	const UpdateDesc& GetUpdateDesc() const { return mUpdateDesc; }
+	// true when the pool runs its own update pass
+	bool IsScheduled() const { return bScheduled; }
+
+	// frame counter the pass checks tick intervals against
+	void SetTickScheduler(const TickScheduler* tickScheduler) { mTickScheduler = tickScheduler; }
+	// where the pass reports its time, typeIndex is the pool's ComponentTypeIndex
+	void SetProfiler(WorldProfiler* profiler, uint32_t typeIndex) { mProfiler = profiler; mTypeIndex = typeIndex; }
+	uint32_t GetTypeIndex() const { return mTypeIndex; }
+	// Component::GetType of the pooled type
+	virtual int GetComponentType() const = 0;
+
+protected:
+	uint32_t GetTickFrame() const { return mTickScheduler ? mTickScheduler->GetFrame() : 0; }
+	// start time for ProfileEnd, 0 while profiling is off
+	int64_t ProfileBegin() const { return mProfiler && mProfiler->IsEnabled() ? WorldProfiler::Now() : 0; }
+	void ProfileEnd(int64_t start, uint32_t calls) const
+	{
+		if (start != 0)
+		{
+			mProfiler->AddComponent(ProfileStage::Update, mTypeIndex, calls, WorldProfiler::Now() - start);
+		}
+	}
+
+private:
+	UpdateDesc mUpdateDesc;
+	const TickScheduler* mTickScheduler = nullptr;
+	WorldProfiler* mProfiler = nullptr;
+	uint32_t mTypeIndex = 0;
+	bool bScheduled = false;
+
+}; // class ComponentPoolBase
+
+// Returns pooled components to their pool, heap components to the heap
+struct ComponentDeleter
+{
+	ComponentPoolBase* pool = nullptr;
+	uint32_t slot = 0;
+
+	void operator()(Component* component) const
+	{
+		if (pool)
+		{
+			pool->Free(component, slot);
+		}
+		else
+		{
+			delete component;
+		}
+	}
+};
+
+using ComponentPoolFactory = std::unique_ptr<ComponentPoolBase>(*)(uint32_t pageSize);
+
+template <class T>
+class ComponentPool : public ComponentPoolBase
+{
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	enum SlotState : uint8_t
+	{
+		kSlotFree,
+		kSlotActive,
+		kSlotInactive
+	};
+
+	std::vector<Storage*> mPages;
+	std::vector<uint8_t> mStates;
+	std::vector<uint32_t> mFreeSlots;
+	uint32_t mPageShift; // page size is a power of two
+	uint32_t mPageMask;
+	uint32_t mCount;
+	uint32_t mHighWater; // one past the highest slot ever used
+
+public:
+	// pageSize is rounded up to a power of two, the first page is allocated right away
+	ComponentPool(uint32_t pageSize);
+	~ComponentPool() override;
+
+	ComponentPool(const ComponentPool&) = delete;
+	ComponentPool& operator=(const ComponentPool&) = delete;
+
+	// slot receives the index to hand back to Free and SetActive
+	T* New(uint32_t& slot);
+	void Free(Component* component, uint32_t slot) override;
+	void SetActive(uint32_t slot, bool active) override;
+	void Reserve(uint32_t capacity) override;
+	void Update(float dTime) override;
+	void Update(float dTime, uint32_t begin, uint32_t end) override;
+
+	// calls func(T&) for every active component in memory order
+	template <class Func>
+	void ForEach(Func func);
+
+	uint32_t GetCount() const override { return mCount; }
+	uint32_t GetCapacity() const override { return static_cast<uint32_t>(mStates.size()); }
+	uint32_t GetSlotCount() const override { return mHighWater; }
+	int GetComponentType() const override { return T::StaticGetType(); }
+
+private:
+	T* Slot(uint32_t index) { return reinterpret_cast<T*>(&mPages[index >> mPageShift][index & mPageMask]); }
+	void AddPage();
+
+}; // class ComponentPool
+
+// matches ComponentPoolFactory, lets non-template code create a pool for T
+template <class T>
+std::unique_ptr<ComponentPoolBase> MakeComponentPool(uint32_t pageSize)
+{
+	return std::make_unique<ComponentPool<T>>(pageSize);
+}
+
+template <class T>
+ComponentPool<T>::ComponentPool(uint32_t pageSize)
+	: mPageShift(0)
+	, mCount(0)
+	, mHighWater(0)
+{
+	ASSERT(pageSize > 0, "[ComponentPool] Page size must not be zero.");
+	while ((1u << mPageShift) < pageSize)
+	{
+		++mPageShift;
+	}
+	mPageMask = (1u << mPageShift) - 1;
+	AddPage();
+}
+
+template <class T>
+ComponentPool<T>::~ComponentPool()
+{
+	ASSERT(mCount == 0, "[ComponentPool] Pool destroyed while components are still alive.");
+	for (Storage* page : mPages)
+	{
+		MEMORY_TRACK_FREE(Core::MemoryCategory::GameObject, sizeof(Storage) << mPageShift);
+		std::free(page);
+	}
+}
+
+template <class T>
+T* ComponentPool<T>::New(uint32_t& slot)
+{
+	if (mFreeSlots.empty())
+	{
+		AddPage();
+	}
+
+	const uint32_t index = mFreeSlots.back();
+	mFreeSlots.pop_back();
+
+	T* component = new(Slot(index)) T();
+	mStates[index] = kSlotActive;
+	mHighWater = std::max(mHighWater, index + 1);
+	++mCount;
+	slot = index;
+	return component;
+}
+
+template <class T>
+void ComponentPool<T>::Free(Component* component, uint32_t slot)
+{
+	ASSERT(slot < mStates.size() && Slot(slot) == static_cast<T*>(component), "[ComponentPool] Component does not belong to this pool.");
+	ASSERT(mStates[slot] != kSlotFree, "[ComponentPool] Component freed twice.");
+
+	Slot(slot)->~T();
+	mStates[slot] = kSlotFree;
+	mFreeSlots.push_back(slot);
+	--mCount;
+
+	while (mHighWater > 0 && mStates[mHighWater - 1] == kSlotFree)
+	{
+		--mHighWater;
+	}
+}
+
+template <class T>
+void ComponentPool<T>::SetActive(uint32_t slot, bool active)
+{
+	ASSERT(slot < mStates.size() && mStates[slot] != kSlotFree, "[ComponentPool] Component is not allocated.");
+	mStates[slot] = active ? kSlotActive : kSlotInactive;
+}
+
+template <class T>
+void ComponentPool<T>::Reserve(uint32_t capacity)
+{
+	while (mStates.size() < capacity)
+	{
+		AddPage();
+	}
+}
+
+template <class T>
+void ComponentPool<T>::AddPage()
+{
+	const uint32_t pageSize = 1u << mPageShift;
+	Storage* page = static_cast<Storage*>(std::malloc(sizeof(Storage) * pageSize));
+	ASSERT(page != nullptr, "[ComponentPool] Failed to allocate pool storage.");
+	MEMORY_TRACK_ALLOC(Core::MemoryCategory::GameObject, sizeof(Storage) * pageSize);
+
+	const uint32_t first = static_cast<uint32_t>(mStates.size());
+	mPages.push_back(page);
+	mStates.resize(first + pageSize, kSlotFree);
+
+	// hand out low slots first so live components stay packed at the front,
+	// new slots go under any that are still free
+	mFreeSlots.insert(mFreeSlots.begin(), pageSize, 0);
+	for (uint32_t i = 0; i < pageSize; ++i)
+	{
+		mFreeSlots[i] = first + pageSize - 1 - i;
+	}
+}
+
+template <class T>
+void ComponentPool<T>::Update(float dTime)
+{
+	const int64_t start = ProfileBegin();
+	const uint32_t frame = GetTickFrame();
+	uint32_t calls = 0;
+	ForEach([dTime, frame, &calls](T& component)
+	{
+		float tickTime;
+		if (component.ConsumeTick(frame, dTime, tickTime))
+		{
+			component.T::Update(tickTime);
+			++calls;
+		}
+	});
+	ProfileEnd(start, calls);
+}
+
+template <class T>
+void ComponentPool<T>::Update(float dTime, uint32_t begin, uint32_t end)
+{
+	const int64_t start = ProfileBegin();
+	const uint32_t frame = GetTickFrame();
+	uint32_t calls = 0;
+	float tickTime;
+	end = std::min(end, mHighWater);
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		if (mStates[i] == kSlotActive && Slot(i)->ConsumeTick(frame, dTime, tickTime))
+		{
+			Slot(i)->T::Update(tickTime);
+			++calls;
+		}
+	}
+	ProfileEnd(start, calls);
+}
+
+template <class T>
+template <class Func>
+void ComponentPool<T>::ForEach(Func func)
+{
+	// re-read mHighWater, components created during the pass get visited too
+	for (uint32_t i = 0; i < mHighWater; ++i)
+	{
+		if (mStates[i] == kSlotActive)
+		{
+			func(*Slot(i));
+		}
+	}
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Common.h"
+
+#include <Core/Inc/RTTI.h>
+
+namespace GameEngine
+{
+namespace Cooked
+{
+
+/*
+Binary form of GameObject templates and levels, produced by the LevelCooker
+tool from the XML sources. Everything is little-endian and 4 byte aligned:
+
+	Header
+	records      template: ComponentRecord + payload, repeated
+	             level:    ObjectRecord, repeated
+	string table NUL terminated strings, referenced by byte offset
+
+A component payload is the component's fixed-layout Record struct, copied
+as is. Bump kVersion whenever a header or Record layout changes.
+*/
+
+const uint32_t kMagic = Core::MakeTypeId("JRCK");
+const uint16_t kVersion = 2;
+const char* const kExtension = ".jrc";
+
+enum class FileType : uint16_t
+{
+	Template,
+	Level
+};
+
+struct Header
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t fileType;
+	uint32_t recordCount;
+	uint32_t recordOffset;
+	uint32_t stringTableOffset;
+	uint32_t stringTableSize;
+};
+
+struct ComponentRecord
+{
+	uint32_t type; // string offset of the component name
+	uint32_t size; // payload bytes following this record, before padding
+};
+
+struct ObjectRecord
+{
+	enum Flags : uint32_t
+	{
+		kHasPosition = 1 << 0
+	};
+
+	uint32_t name; // string offset
+	uint32_t templateName; // string offset
+	uint32_t flags;
+	float position[3];
+};
+
+static_assert(sizeof(Header) == 24, "[Cooked] Header layout changed, bump kVersion.");
+static_assert(sizeof(ComponentRecord) == 8, "[Cooked] ComponentRecord layout changed, bump kVersion.");
+static_assert(sizeof(ObjectRecord) == 24, "[Cooked] ObjectRecord layout changed, bump kVersion.");
+
+// true if the file name carries the cooked extension
+bool IsCookedFile(const char* fileName);
+// foo.xml -> foo.jrc
+std::string GetCookedFileName(const char* fileName);
+
+// Validating view over a cooked file held in memory, typically a Core::MappedFile
+class Reader
+{
+public:
+	Reader();
+
+	// checks the header, bounds and string table once so later reads need no checks
+	bool Open(const uint8_t* data, size_t size, FileType fileType);
+
+	uint32_t GetRecordCount() const { return mHeader->recordCount; }
+	const char* GetString(uint32_t offset) const { return mStrings + offset; }
+
+	// level files only
+	const ObjectRecord* GetObjects() const;
+
+	// template files only, calls func(type, payload, size) for each component
+	template <class Func>
+	void ForEachComponent(Func func) const;
+
+private:
+	const uint8_t* mData;
+	const Header* mHeader;
+	const char* mStrings;
+};
+
+// Collects records and strings in memory and writes the finished file
+class Writer
+{
+public:
+	Writer(FileType fileType);
+
+	uint32_t AddString(const char* str);
+	void AddComponent(const char* type, const void* data, uint32_t size);
+	void AddObject(const ObjectRecord& object);
+
+	bool Save(const char* fileName) const;
+
+private:
+	FileType mFileType;
+	uint32_t mRecordCount;
+	std::vector<uint8_t> mRecords;
+	std::vector<char> mStrings;
+	std::unordered_map<std::string, uint32_t> mStringOffsets;
+};
+
+inline uint32_t Align4(uint32_t size)
+{
+	return (size + 3) & ~3u;
+}
+
+template <class Func>
+void Reader::ForEachComponent(Func func) const
+{
+	ASSERT(mHeader->fileType == static_cast<uint16_t>(FileType::Template), "[Cooked] Not a template file.");
+	const uint8_t* cursor = mData + mHeader->recordOffset;
+	for (uint32_t i = 0; i < mHeader->recordCount; ++i)
+	{
+		const ComponentRecord* record = reinterpret_cast<const ComponentRecord*>(cursor);
+		cursor += sizeof(ComponentRecord);
+		func(GetString(record->type), cursor, record->size);
+		cursor += Align4(record->size);
+	}
+}
+
+} // namespace Cooked
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CookedFormat.h"
+
+namespace GameEngine
+{
+
+/*
+Converts XML templates and levels into the cooked binary format. Each
+component type needs a cook function that decodes its XML element into the
+payload the matching GameObjectFactory load function expects. The built-in
+components are registered by the constructor.
+*/
+class Cooker
+{
+public:
+	using CookFunc = std::function<void(const TiXmlNode*, std::vector<uint8_t>&)>;
+
+	Cooker();
+
+	// T provides a Record struct and a static CookFunc(const TiXmlNode*, Record&)
+	template <class T>
+	void Register(std::string name);
+	// component type without parameters, cooks to an empty record
+	void Register(std::string name);
+	void Register(std::string name, CookFunc func);
+
+	// cooks a template (<GameObject> root) or a level (<GameObjectList> root);
+	// template references inside levels are rewritten to their cooked names
+	bool Cook(const char* fileName, const char* cookedFileName);
+
+private:
+	bool CookTemplate(const TiXmlElement* root, Cooked::Writer& writer);
+	bool CookLevel(const TiXmlElement* root, Cooked::Writer& writer);
+
+	std::unordered_map<std::string, CookFunc> mCookFuncs;
+};
+
+template <class T>
+void Cooker::Register(std::string name)
+{
+	Register(std::move(name), [](const TiXmlNode* node, std::vector<uint8_t>& payload)
+	{
+		typename T::Record record;
+		T::CookFunc(node, record);
+		payload.resize(sizeof(record));
+		std::memcpy(payload.data(), &record, sizeof(record));
+	});
+}
+
+} // namespace GameEngine
\ No newline at end of file
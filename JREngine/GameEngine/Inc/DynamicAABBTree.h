@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Common.h"
+
+#include <queue>
+
+namespace GameEngine
+{
+
+/*
+Bounding volume hierarchy over moving boxes. Each leaf stores a fat box, the
+real bounds grown by a margin, so small movements do not touch the tree; a
+proxy is only removed and reinserted once its bounds leave the fat box.
+Insertion picks the sibling with the smallest surface area increase and
+rotations keep the tree balanced, so queries stay logarithmic as objects move.
+*/
+class DynamicAABBTree
+{
+public:
+	static const int32_t kNullNode = -1;
+
+	// result of a node test during Traverse
+	enum class Overlap
+	{
+		Outside, // skip the subtree
+		Intersect, // test the children
+		Inside // accept every leaf below without further tests
+	};
+
+	DynamicAABBTree(float margin = 0.1f);
+
+	int32_t CreateProxy(const Math::AABB& aabb, void* userData);
+	void DestroyProxy(int32_t proxy);
+	// returns true if the proxy had to be reinserted
+	bool MoveProxy(int32_t proxy, const Math::AABB& aabb);
+	void Clear();
+
+	void* GetUserData(int32_t proxy) const { return mNodes[proxy].userData; }
+	Math::AABB GetFatAABB(int32_t proxy) const;
+
+	// func(proxy) for every proxy whose fat box overlaps the box
+	template <class Func>
+	void Query(const Math::AABB& aabb, Func func) const;
+
+	// Walks the subtree under node. test(min, max) classifies each node's
+	// box, func(proxy) gets every accepted leaf. Starting below the root
+	// lets several threads share one traversal.
+	template <class Test, class Func>
+	void Traverse(int32_t node, Test test, Func func) const;
+
+	// func(proxy, maxDistance) for every proxy whose fat box the ray hits
+	// within maxDistance, in units of the ray direction's length. func returns
+	// the new max distance: its own hit distance clips the ray, maxDistance
+	// keeps all of it, a negative value ends the cast.
+	template <class Func>
+	void RayCast(const Math::Ray& ray, float maxDistance, Func func) const;
+
+	// Visits proxies nearest first. distance(proxy) returns the squared
+	// distance from point to the proxy's own bounds, which can not be less
+	// than to its fat box. func(proxy, distanceSqr) returns false to stop.
+	template <class Distance, class Func>
+	void VisitNearest(const Math::Vector3& point, Distance distance, Func func) const;
+
+	// collects up to count disjoint subtrees that together cover the tree
+	void Split(uint32_t count, std::vector<int32_t>& roots) const;
+
+	int32_t GetRoot() const { return mRoot; }
+	uint32_t GetProxyCount() const { return mProxyCount; }
+	int32_t GetHeight() const { return mRoot == kNullNode ? 0 : mNodes[mRoot].height; }
+
+private:
+	struct Node
+	{
+		Math::Vector3 min;
+		Math::Vector3 max;
+		void* userData;
+		int32_t parent; // next free node while on the free list
+		int32_t child1;
+		int32_t child2;
+		int32_t height; // 0 for leaves, -1 for free nodes
+
+		bool IsLeaf() const { return child1 == kNullNode; }
+	};
+
+	static float DistanceSqr(const Math::Vector3& point, const Math::Vector3& min, const Math::Vector3& max);
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t node);
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+	void Refit(int32_t node);
+	int32_t Balance(int32_t node);
+	int32_t Rotate(int32_t node, int32_t up, int32_t other);
+
+	std::vector<Node> mNodes;
+	int32_t mRoot;
+	int32_t mFreeList;
+	uint32_t mProxyCount;
+	float mMargin;
+
+}; // class DynamicAABBTree
+
+template <class Func>
+void DynamicAABBTree::Query(const Math::AABB& aabb, Func func) const
+{
+	const Math::Vector3 queryMin = aabb.center - aabb.extend;
+	const Math::Vector3 queryMax = aabb.center + aabb.extend;
+	Traverse(mRoot, [&](const Math::Vector3& min, const Math::Vector3& max)
+	{
+		const bool bOverlaps =
+			min.x <= queryMax.x && max.x >= queryMin.x &&
+			min.y <= queryMax.y && max.y >= queryMin.y &&
+			min.z <= queryMax.z && max.z >= queryMin.z;
+		return bOverlaps ? Overlap::Intersect : Overlap::Outside;
+	}, func);
+}
+
+template <class Test, class Func>
+void DynamicAABBTree::Traverse(int32_t node, Test test, Func func) const
+{
+	if (node == kNullNode)
+	{
+		return;
+	}
+
+	// explicit stack, entries carry whether an ancestor was fully inside
+	struct Entry
+	{
+		int32_t node;
+		bool bInside;
+	};
+	Core::InlineVector<Entry, 64> stack;
+	stack.push_back({ node, false });
+	while (!stack.empty())
+	{
+		const Entry entry = stack.back();
+		stack.pop_back();
+
+		const Node& current = mNodes[entry.node];
+		bool bInside = entry.bInside;
+		if (!bInside)
+		{
+			const Overlap overlap = test(current.min, current.max);
+			if (overlap == Overlap::Outside)
+			{
+				continue;
+			}
+			bInside = overlap == Overlap::Inside;
+		}
+
+		if (current.IsLeaf())
+		{
+			func(entry.node);
+		}
+		else
+		{
+			stack.push_back({ current.child1, bInside });
+			stack.push_back({ current.child2, bInside });
+		}
+	}
+}
+
+template <class Func>
+void DynamicAABBTree::RayCast(const Math::Ray& ray, float maxDistance, Func func) const
+{
+	const Math::Vector3 invDir(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+	Core::InlineVector<int32_t, 64> stack;
+	if (mRoot != kNullNode)
+	{
+		stack.push_back(mRoot);
+	}
+	while (!stack.empty())
+	{
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& node = mNodes[index];
+
+		// slab test, the ray is clipped to [0, maxDistance]
+		const float tx1 = (node.min.x - ray.origin.x) * invDir.x;
+		const float tx2 = (node.max.x - ray.origin.x) * invDir.x;
+		const float ty1 = (node.min.y - ray.origin.y) * invDir.y;
+		const float ty2 = (node.max.y - ray.origin.y) * invDir.y;
+		const float tz1 = (node.min.z - ray.origin.z) * invDir.z;
+		const float tz2 = (node.max.z - ray.origin.z) * invDir.z;
+		const float tEnter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+		const float tExit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+		if (tEnter > tExit)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			maxDistance = func(index, maxDistance);
+			if (maxDistance < 0.0f)
+			{
+				return;
+			}
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+template <class Distance, class Func>
+void DynamicAABBTree::VisitNearest(const Math::Vector3& point, Distance distance, Func func) const
+{
+	// best first search, a leaf is reported once its exact distance comes
+	// up in the queue since everything left is at least as far away
+	struct Entry
+	{
+		float distanceSqr;
+		int32_t node;
+		bool bExact;
+
+		bool operator<(const Entry& other) const { return distanceSqr > other.distanceSqr; }
+	};
+
+	if (mRoot == kNullNode)
+	{
+		return;
+	}
+
+	std::priority_queue<Entry> queue;
+	queue.push({ DistanceSqr(point, mNodes[mRoot].min, mNodes[mRoot].max), mRoot, false });
+	while (!queue.empty())
+	{
+		const Entry entry = queue.top();
+		queue.pop();
+
+		if (entry.bExact)
+		{
+			if (!func(entry.node, entry.distanceSqr))
+			{
+				return;
+			}
+			continue;
+		}
+
+		const Node& node = mNodes[entry.node];
+		if (node.IsLeaf())
+		{
+			queue.push({ distance(entry.node), entry.node, true });
+		}
+		else
+		{
+			queue.push({ DistanceSqr(point, mNodes[node.child1].min, mNodes[node.child1].max), node.child1, false });
+			queue.push({ DistanceSqr(point, mNodes[node.child2].min, mNodes[node.child2].max), node.child2, false });
+		}
+	}
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#if !defined(CORE_HEADLESS)
+
 #include "Component.h"
 
 namespace GameEngine
@@ -15,6 +17,9 @@ public:
 	REGISTER_TYPE(FPCC); // (FPC)ontroller(C)omponent
 
 	static void CreateFunc(GameObject* gameObj, const TiXmlNode* node);
+	static void CloneFunc(GameObject* gameObj, const Component* source);
+	// takes no parameters, the cooked record is empty
+	static void LoadFunc(GameObject* gameObj, const void* data, uint32_t size);
 
 	FPControllerComponent();
 	~FPControllerComponent() override;
@@ -23,4 +28,6 @@ public:
 
 };
 
-} // namespace GameEngine
\ No newline at end of file
+} // namespace GameEngine
+
+#endif // #if !defined(CORE_HEADLESS)
\ No newline at end of file
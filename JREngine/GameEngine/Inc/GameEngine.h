@@ -8,6 +8,25 @@
 #include "AABoxColliderComponent.h"
 #include "TransformComponent.h"
 
+#include "CollisionService.h"
+#include "ComponentPool.h"
+#include "CookedFormat.h"
+#include "Cooker.h"
+#include "DynamicAABBTree.h"
 #include "GameObject.h"
 #include "GameObjectFactory.h"
-#include "World.h"
\ No newline at end of file
+#include "LevelFile.h"
+#include "LevelStreamer.h"
+#include "MessageBus.h"
+#include "QueryService.h"
+#include "RenderBackend.h"
+#include "RenderPacket.h"
+#include "RenderPipeline.h"
+#include "TickScheduler.h"
+#include "TransformService.h"
+#include "UpdateDesc.h"
+#include "UpdateScheduler.h"
+#include "VisibilityService.h"
+#include "World.h"
+#include "WorldProfiler.h"
+#include "WorldSnapshot.h"
\ No newline at end of file
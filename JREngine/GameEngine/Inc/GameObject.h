@@ -1,27 +1,48 @@
 #pragma once
 
+#include "ComponentPool.h"
+
+#include <Core/Inc/RTTI.h>
 
 namespace GameEngine
 {
 
 class Component;
 class GameObject;
+class World;
 
 using GameObjectAllocator = Core::TypedAllocator<GameObject>;
 using GameObjectHandlePool = Core::HandlePool<GameObject>;
 using GameObjectHandle = Core::Handle<GameObject>;
+using ComponentTypeIndex = Core::TypeIndex<Component>;
 
 
 class GameObject
 {
-	using Components = std::vector<std::unique_ptr<Component>>;
+	using ComponentPtr = std::unique_ptr<Component, ComponentDeleter>;
+	using Components = Core::InlineVector<ComponentPtr, 4>;
+	friend class GameObjectFactory;
+	friend class VisibilityService;
 	friend class World;
+	friend class WorldSnapshot;
+
+	static const uint32_t kMaxComponentTypes = 64;
+	static const uint8_t kNoComponent = 0xff;
+	static const uint32_t kNoTemplate = 0xffffffff;
 
 	Components mComponents;
+	// mComponentMask has a bit per component type index, mComponentSlots maps
+	// the type index to the component's position in mComponents
+	uint64_t mComponentMask;
+	uint8_t mComponentSlots[kMaxComponentTypes];
 	std::string mName;
 	GameObjectHandle mHandle;
 
 	World* mWorld;
+	uint32_t mUpdateIndex; // position in World::mUpdateList
+	uint32_t mNameIndex; // position in the World's name index bucket
+	uint32_t mVisibilityIndex; // position in the VisibilityService entries
+	uint32_t mTemplateId; // index into World::mTemplateNames, kNoTemplate for prototypes
 
 public:
 	GameObject();
@@ -31,9 +52,14 @@ public:
 	void Terminate();
 
 	void Update(float dTime);
-	void Render();
+	// copies render state into the list, safe to run for several objects in parallel
+	void Extract(RenderList& list);
 	void Render2D();
 
+	// puts every component to sleep or wakes them, see Component::Sleep
+	void Sleep();
+	void Wake();
+
 	const char* GetName() const { return mName.c_str(); }
 	World& GetWorld() { return *mWorld; }
 	const World& GetWorld() const { return *mWorld; }
@@ -49,14 +75,42 @@ public:
 	template <class T>
 	const T* GetComponent() const;
 
+	template <class T>
+	bool HasComponent() const;
+
+private:
+	ComponentPoolBase* GetComponentPool(uint32_t typeIndex, ComponentPoolFactory factory) const;
+	void SetComponentsActive(bool active);
+	void RenderComponents(ProfileStage stage, RenderList* list);
+
 }; // class GameObject
 
 template <class T>
 typename std::enable_if<std::is_base_of<Component,T>::value, T*>::type
 GameObject::AddComponent()
 {
+	const uint32_t typeIndex = ComponentTypeIndex::Get<T>();
+	ASSERT(typeIndex < kMaxComponentTypes, "[GameObject] Too many component types, raise kMaxComponentTypes.");
+	ASSERT(!HasComponent<T>(), "[GameObject] Object already has a component of this type.");
+	ASSERT(mComponents.size() < kNoComponent, "[GameObject] Too many components on one object.");
+
 	// create a component of the given type and return a pointer to it to be modified
-	mComponents.emplace_back(std::make_unique<T>());
+	mComponentSlots[typeIndex] = static_cast<uint8_t>(mComponents.size());
+	mComponentMask |= (uint64_t)1 << typeIndex;
+	// objects in a world take components from the world's pool for the type,
+	// objects outside of one (template prototypes) use the heap
+	ComponentDeleter deleter;
+	T* component = nullptr;
+	if (ComponentPoolBase* pool = GetComponentPool(typeIndex, &MakeComponentPool<T>))
+	{
+		component = static_cast<ComponentPool<T>*>(pool)->New(deleter.slot);
+		deleter.pool = pool;
+	}
+	else
+	{
+		component = new T();
+	}
+	mComponents.emplace_back(component, deleter);
 	auto& newComp = mComponents.back();
 	newComp->mGameObject = this;
 	return static_cast<T*>(newComp.get());
@@ -73,16 +127,20 @@ T* GameObject::GetComponent()
 template <class T>
 const T* GameObject::GetComponent() const
 {
-	// search for a component of the given type
-	for (auto& component : mComponents)
+	// look up the slot by type index, nullptr if no such component exists
+	const uint32_t typeIndex = ComponentTypeIndex::Get<T>();
+	if (typeIndex >= kMaxComponentTypes || mComponentSlots[typeIndex] == kNoComponent)
 	{
-		if (component->GetType() == T::StaticGetType())
-		{
-			return static_cast<const T*>(component.get());
-		}
+		return nullptr;
 	}
-	// if no such component exists, return nullptr
-	return nullptr;
+	return static_cast<const T*>(mComponents[mComponentSlots[typeIndex]].get());
+}
+
+template <class T>
+bool GameObject::HasComponent() const
+{
+	const uint32_t typeIndex = ComponentTypeIndex::Get<T>();
+	return typeIndex < kMaxComponentTypes && (mComponentMask & ((uint64_t)1 << typeIndex)) != 0;
 }
 
 } // namespace GameEngine
\ No newline at end of file
@@ -6,21 +6,84 @@
 namespace GameEngine
 {
 
+class World;
+
+/*
+Builds GameObjects from XML templates. Each template file is parsed once into
+a prototype object; later Creates copy the prototype's components through the
+registered clone functions, so spawning does no file I/O or text parsing.
+Component types registered without a clone function are rebuilt from the
+cached XML element instead.
+
+Cooked templates (Cooked::kExtension, see Cooker) skip XML entirely: each
+record is handed to the type's load function to build the prototype.
+*/
 class GameObjectFactory
 {
+public:
+	struct Template;
+
+private:
 	using CreateFunc = std::function<void(GameObject*, const TiXmlNode*)>;
+	using CloneFunc = std::function<void(GameObject*, const Component*)>;
+	using LoadFunc = std::function<void(GameObject*, const void*, uint32_t)>;
+
+	struct Funcs
+	{
+		CreateFunc create;
+		CloneFunc clone;
+		LoadFunc load;
+	};
+
+	struct Instruction
+	{
+		const Funcs* funcs;
+		const Component* source; // set when the type can be cloned
+		const TiXmlElement* element; // fallback for types without a clone function
+	};
 
 	GameObjectAllocator& mGameObjectAllocator;
-	std::unordered_map<std::string, CreateFunc> mCreateFuncMap;
+	World& mWorld;
+	std::unordered_map<std::string, Funcs> mCreateFuncMap;
+	std::unordered_map<uint32_t, std::vector<std::unique_ptr<Template>>> mTemplates; // file name hash -> templates
 
 public:
+	GameObjectFactory(GameObjectAllocator& allocator, World& world);
+	~GameObjectFactory();
 
-	GameObjectFactory(GameObjectAllocator& allocator);
-
-	bool Register(std::string name, CreateFunc func);
+	bool Register(std::string name, CreateFunc func, CloneFunc cloneFunc = nullptr, LoadFunc loadFunc = nullptr);
 
 	GameObject* Create(const char* templateFileName);
+	// appends up to count new objects, fewer if the allocator runs out;
+	// components are added one template entry at a time across all objects
+	uint32_t CreateBatch(const char* templateFileName, uint32_t count, std::vector<GameObject*>& gameObjects);
 	void Destroy(GameObject* gameObject);
+
+	// parses a template ahead of the first Create, returns false if it fails to load
+	bool Preload(const char* templateFileName);
+
+	// drops cached templates so the next Create reads the file again, call
+	// after a template changed on disk
+	void Invalidate(const char* templateFileName);
+	void InvalidateAll();
+
+	// Split preload for loading threads: PrepareTemplate only reads the
+	// registered functions, so it may run on any thread as long as nothing is
+	// registered meanwhile. AddTemplate then caches the result on the main thread.
+	std::unique_ptr<Template> PrepareTemplate(const char* templateFileName) const;
+	void AddTemplate(std::unique_ptr<Template> objectTemplate);
+
+private:
+	const Template* FindTemplate(const char* templateFileName);
+	std::unique_ptr<Template> LoadCookedTemplate(const char* templateFileName) const;
+};
+
+struct GameObjectFactory::Template
+{
+	std::string fileName;
+	std::unique_ptr<TiXmlDocument> document; // only kept while an instruction needs it
+	std::unique_ptr<GameObject> prototype;
+	std::vector<Instruction> instructions;
 };
 
 } // namespace GameEngine
\ No newline at end of file
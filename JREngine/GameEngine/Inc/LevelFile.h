@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Common.h"
+
+namespace GameEngine
+{
+
+// One object placement read from a level file
+struct LevelEntry
+{
+	std::string name;
+	std::string templateFileName;
+	Math::Vector3 position = Math::Vector3::Zero();
+	bool bHasPosition = false;
+	// TODO: Override data for each component
+};
+
+// Decodes a level, cooked or XML depending on the extension, without creating
+// anything. Touches no engine state, so it is safe on a loading thread.
+bool ReadLevel(const char* levelFileName, std::vector<LevelEntry>& entries);
+// XML level from an already parsed <GameObjectList> element
+bool ReadLevel(const TiXmlElement* root, std::vector<LevelEntry>& entries);
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "GameObjectFactory.h"
+#include "LevelFile.h"
+
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace GameEngine
+{
+
+class World;
+
+/*
+Loads and unloads levels over several frames. A loading thread reads the
+level file and prepares every template it references; the main thread then
+creates and initializes the objects in Update, stopping once the frame
+budget is used up. Each loaded level remembers its objects so it can be
+unloaded the same way, one slice per frame.
+
+Component types must not be registered with the factory while a level is
+being read.
+*/
+class LevelStreamer
+{
+public:
+	using LevelId = uint32_t;
+	static const LevelId kInvalidLevel = 0;
+
+	enum class State
+	{
+		None,		// unknown id, or fully unloaded
+		Reading,	// loading thread is reading the file and templates
+		Activating,	// objects are being created on the main thread
+		Loaded,
+		Unloading,	// objects are being destroyed on the main thread
+		Failed		// file could not be read, Unload to forget it
+	};
+
+	struct Progress
+	{
+		State state = State::None;
+		uint32_t activeCount = 0; // objects currently alive for the level
+		uint32_t totalCount = 0; // objects in the level file, 0 while reading
+		uint32_t failedCount = 0; // objects skipped because their template failed to load
+
+		// 0..1, how far the level is towards Loaded (or None when unloading)
+		float GetFraction() const;
+	};
+
+	LevelStreamer(World& world);
+	~LevelStreamer();
+
+	LevelStreamer(const LevelStreamer&) = delete;
+	LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+	// main thread time spent creating or destroying objects per Update
+	void SetFrameBudget(float milliseconds) { mFrameBudget = milliseconds; }
+	float GetFrameBudget() const { return mFrameBudget; }
+
+	LevelId Load(const char* levelFileName);
+	// stops a load in progress and removes whatever it already created,
+	// does nothing for levels that finished loading
+	void Cancel(LevelId levelId);
+	// destroys the level's objects over the next frames
+	void Unload(LevelId levelId);
+
+	Progress GetProgress(LevelId levelId) const;
+	bool IsBusy() const;
+
+	// called by World::Update outside of the object update
+	void Update();
+	// joins the loading threads and forgets all levels without destroying
+	// anything, for World::Terminate
+	void Terminate();
+
+private:
+	using Clock = std::chrono::steady_clock;
+	using TemplatePtr = std::unique_ptr<GameObjectFactory::Template>;
+
+	struct Level
+	{
+		LevelId id = kInvalidLevel;
+		std::string fileName;
+		State state = State::Reading;
+
+		// written by the loading thread until bReadDone is set
+		std::thread thread;
+		std::atomic<bool> bReadDone{ false };
+		std::atomic<bool> bCancel{ false };
+		bool bReadFailed = false;
+		std::vector<LevelEntry> entries;
+		std::vector<TemplatePtr> templates;
+		std::unordered_set<std::string> failedTemplates;
+
+		uint32_t nextEntry = 0;
+		uint32_t totalCount = 0;
+		uint32_t failedCount = 0;
+		std::vector<GameObjectHandle> objects;
+	};
+
+	static void Read(Level& level, const GameObjectFactory& factory);
+
+	Level* FindLevel(LevelId levelId);
+	const Level* FindLevel(LevelId levelId) const;
+	void FinishRead(Level& level);
+	// both do at least one object, then continue until the deadline
+	void Activate(Level& level, Clock::time_point deadline);
+	void Deactivate(Level& level, Clock::time_point deadline);
+
+	World& mWorld;
+	std::vector<std::unique_ptr<Level>> mLevels;
+	LevelId mNextId;
+	float mFrameBudget;
+
+}; // class LevelStreamer
+
+} // namespace GameEngine
\ No newline at end of file
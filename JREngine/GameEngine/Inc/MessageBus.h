@@ -0,0 +1,352 @@
+#pragma once
+
+#include "GameObject.h"
+
+#include <Core/Inc/RTTI.h>
+
+#include <iterator>
+#include <mutex>
+
+namespace GameEngine
+{
+
+// Gives a message struct the type ID MessageBus reports it under. Unlike
+// REGISTER_TYPE it adds nothing virtual, messages stay plain data.
+#define REGISTER_MESSAGE(TypeId)\
+	static int StaticGetType() { return Core::MakeTypeId(#TypeId); }
+
+/*
+World-level queue for messages between components and services. Each message
+type has its own channel: a bounded MpmcQueue that any thread may publish to
+during the update passes, backed by a locked overflow list for when it fills
+up. Nothing is delivered on publish; Dispatch runs at the phase boundaries
+and hands each subscriber every queued message of its type as one
+contiguous batch.
+
+A channel that overflowed grows at the next Dispatch, so the locked path is
+only taken until the queue has seen its peak. Messages of types nobody
+registered or subscribed to are dropped on publish.
+
+Register, Subscribe and Unsubscribe are main thread only and must not run
+while an update pass is publishing.
+*/
+class MessageBus
+{
+public:
+	static const uint32_t kDefaultCapacity = 256;
+	// handlers publishing in response to each other get this many rounds per Dispatch
+	static const uint32_t kMaxDispatchRounds = 8;
+
+	template <class T>
+	struct Envelope
+	{
+		GameObjectHandle target; // invalid for Publish
+		T message;
+	};
+
+	template <class T>
+	using Handler = std::function<void(const Envelope<T>* envelopes, uint32_t count)>;
+
+	struct Stats
+	{
+		int type = 0; // REGISTER_MESSAGE id
+		uint64_t published = 0;
+		uint64_t delivered = 0; // counted once per message, not per handler
+		uint64_t overflowed = 0; // took the locked path because the queue was full
+		uint32_t capacity = 0;
+		uint32_t peak = 0; // largest batch delivered at once
+	};
+
+	MessageBus();
+	~MessageBus();
+
+	MessageBus(const MessageBus&) = delete;
+	MessageBus& operator=(const MessageBus&) = delete;
+
+	// creates T's channel with room for capacity messages between
+	// dispatches before it overflows, Subscribe creates it as well
+	template <class T>
+	void Register(uint32_t capacity = kDefaultCapacity);
+	template <class T>
+	bool IsRegistered() const;
+
+	// returns an ID for Unsubscribe, never 0
+	template <class T>
+	uint32_t Subscribe(Handler<T> handler);
+	void Unsubscribe(uint32_t subscription);
+
+	// queues the message for the next Dispatch, safe from any thread
+	template <class T>
+	void Publish(const T& message);
+	// like Publish, and wakes the target (GameObject::Wake) on delivery
+	template <class T>
+	void Send(GameObjectHandle target, const T& message);
+
+	// delivers everything queued, channel by channel; messages published by
+	// handlers are delivered by the same call
+	void Dispatch();
+
+	// drops queued messages and subscriptions
+	void Clear();
+
+	void GetStats(std::vector<Stats>& stats) const;
+	uint64_t GetDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+	void LogStats() const;
+	void ResetStats();
+
+private:
+	using MessageTypeIndex = Core::TypeIndex<MessageBus>;
+
+	class ChannelBase
+	{
+	public:
+		ChannelBase(int type) { mStats.type = type; }
+		virtual ~ChannelBase() {}
+
+		// delivers one round, false if there was nothing to deliver
+		virtual bool Deliver() = 0;
+		virtual bool Unsubscribe(uint32_t subscription) = 0;
+
+		Stats GetStats() const;
+		void ResetStats();
+
+	protected:
+		Stats mStats; // delivered, capacity and peak, the rest are below
+		std::atomic<uint64_t> mPublished{ 0 };
+		std::atomic<uint64_t> mOverflowed{ 0 };
+	};
+
+	template <class T>
+	class Channel;
+
+	template <class T>
+	Channel<T>* GetChannel() const;
+
+	std::vector<std::unique_ptr<ChannelBase>> mChannels; // indexed by MessageTypeIndex
+	std::atomic<uint64_t> mDropped;
+	uint32_t mNextSubscription;
+	bool bDispatching;
+
+}; // class MessageBus
+
+template <class T>
+class MessageBus::Channel : public ChannelBase
+{
+	struct Subscription
+	{
+		uint32_t id; // 0 once unsubscribed during a dispatch
+		Handler<T> handler;
+	};
+
+	std::unique_ptr<Core::MpmcQueue<Envelope<T>>> mQueue;
+	std::mutex mOverflowMutex;
+	std::vector<Envelope<T>> mOverflow;
+	std::vector<Envelope<T>> mBatch; // what the current round delivers
+	std::vector<Subscription> mSubscriptions;
+	std::vector<Subscription> mPending; // subscribed during a round, added after it
+	bool bDelivering = false;
+	bool bPrune = false;
+
+public:
+	Channel(uint32_t capacity)
+		: ChannelBase(T::StaticGetType())
+	{
+		Reserve(capacity);
+	}
+
+	void Reserve(uint32_t capacity)
+	{
+		// only grows while the queue is empty, nothing is lost
+		if (!mQueue || mQueue->Capacity() < capacity)
+		{
+			ASSERT(!mQueue || mQueue->Size() == 0, "[MessageBus] Channel resized while messages are queued.");
+			mQueue = std::make_unique<Core::MpmcQueue<Envelope<T>>>(std::max(capacity, 2u));
+			mStats.capacity = mQueue->Capacity();
+		}
+	}
+
+	void Push(GameObjectHandle target, const T& message)
+	{
+		mPublished.fetch_add(1, std::memory_order_relaxed);
+		Envelope<T> envelope{ target, message };
+		if (!mQueue->TryPush(envelope))
+		{
+			std::lock_guard<std::mutex> lock(mOverflowMutex);
+			mOverflow.push_back(envelope);
+			mOverflowed.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void Subscribe(uint32_t id, Handler<T> handler)
+	{
+		// growing mSubscriptions could move the handler that is running, so
+		// the round's subscribers stay put until it ends
+		if (bDelivering)
+		{
+			mPending.push_back({ id, std::move(handler) });
+		}
+		else
+		{
+			mSubscriptions.push_back({ id, std::move(handler) });
+		}
+	}
+
+	bool Unsubscribe(uint32_t subscription) override
+	{
+		for (size_t i = 0; i < mSubscriptions.size(); ++i)
+		{
+			if (mSubscriptions[i].id == subscription)
+			{
+				if (bDelivering)
+				{
+					// the handler may be the one running, remove it after the round
+					mSubscriptions[i].id = 0;
+					bPrune = true;
+				}
+				else
+				{
+					mSubscriptions.erase(mSubscriptions.begin() + i);
+				}
+				return true;
+			}
+		}
+		for (size_t i = 0; i < mPending.size(); ++i)
+		{
+			if (mPending[i].id == subscription)
+			{
+				// not called yet, nothing is running it
+				mPending.erase(mPending.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Deliver() override
+	{
+		const uint32_t queued = mQueue->Size();
+		mBatch.resize(queued);
+		mBatch.resize(mQueue->PopBatch(mBatch.data(), queued));
+		{
+			std::lock_guard<std::mutex> lock(mOverflowMutex);
+			if (!mOverflow.empty())
+			{
+				mBatch.insert(mBatch.end(), mOverflow.begin(), mOverflow.end());
+				mOverflow.clear();
+				// the queue was just emptied and nothing else publishes at a
+				// dispatch point, so it can be swapped for a larger one
+				Reserve(Core::NextPowerOfTwo(static_cast<uint32_t>(mBatch.size()) + 1));
+			}
+		}
+		if (mBatch.empty())
+		{
+			return false;
+		}
+
+		const uint32_t count = static_cast<uint32_t>(mBatch.size());
+		for (auto& envelope : mBatch)
+		{
+			if (GameObject* target = envelope.target.Get())
+			{
+				target->Wake();
+			}
+		}
+
+		bDelivering = true;
+		const size_t subscriptionCount = mSubscriptions.size();
+		for (size_t i = 0; i < subscriptionCount; ++i)
+		{
+			if (mSubscriptions[i].id != 0)
+			{
+				mSubscriptions[i].handler(mBatch.data(), count);
+			}
+		}
+		bDelivering = false;
+
+		if (bPrune)
+		{
+			mSubscriptions.erase(std::remove_if(mSubscriptions.begin(), mSubscriptions.end(), [](const Subscription& subscription)
+			{
+				return subscription.id == 0;
+			}), mSubscriptions.end());
+			bPrune = false;
+		}
+		if (!mPending.empty())
+		{
+			mSubscriptions.insert(mSubscriptions.end(), std::make_move_iterator(mPending.begin()), std::make_move_iterator(mPending.end()));
+			mPending.clear();
+		}
+
+		mStats.delivered += count;
+		mStats.peak = std::max(mStats.peak, count);
+		return true;
+	}
+
+}; // class MessageBus::Channel
+
+template <class T>
+MessageBus::Channel<T>* MessageBus::GetChannel() const
+{
+	const uint32_t index = MessageTypeIndex::Get<T>();
+	return index < mChannels.size() ? static_cast<Channel<T>*>(mChannels[index].get()) : nullptr;
+}
+
+template <class T>
+void MessageBus::Register(uint32_t capacity)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "[MessageBus] Messages must be plain data.");
+
+	const uint32_t index = MessageTypeIndex::Get<T>();
+	if (index >= mChannels.size())
+	{
+		mChannels.resize(index + 1);
+	}
+	if (!mChannels[index])
+	{
+		mChannels[index] = std::make_unique<Channel<T>>(capacity);
+	}
+	else
+	{
+		static_cast<Channel<T>*>(mChannels[index].get())->Reserve(capacity);
+	}
+}
+
+template <class T>
+bool MessageBus::IsRegistered() const
+{
+	return GetChannel<T>() != nullptr;
+}
+
+template <class T>
+uint32_t MessageBus::Subscribe(Handler<T> handler)
+{
+	if (!IsRegistered<T>())
+	{
+		Register<T>();
+	}
+	const uint32_t id = mNextSubscription++;
+	GetChannel<T>()->Subscribe(id, std::move(handler));
+	return id;
+}
+
+template <class T>
+void MessageBus::Publish(const T& message)
+{
+	Send(GameObjectHandle(), message);
+}
+
+template <class T>
+void MessageBus::Send(GameObjectHandle target, const T& message)
+{
+	Channel<T>* channel = GetChannel<T>();
+	if (channel)
+	{
+		channel->Push(target, message);
+	}
+	else
+	{
+		mDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+} // namespace GameEngine
\ No newline at end of file
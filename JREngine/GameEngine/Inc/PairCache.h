@@ -0,0 +1,71 @@
+#pragma once
+
+#include "GameObject.h"
+
+namespace GameEngine
+{
+
+/*
+Set of object pairs that persists between frames, used to tell new contacts
+from ongoing ones. Pairs are keyed by the two handle IDs in sorted order and
+stored in an open-addressing table with linear probing; removal shifts the
+following entries back so no tombstones build up.
+*/
+class PairCache
+{
+public:
+	struct Pair
+	{
+		uint64_t key = 0; // 0 marks an empty slot
+		GameObjectHandle objectA;
+		GameObjectHandle objectB;
+		uint32_t frame = 0; // last frame the pair was touched
+	};
+
+	PairCache(uint32_t capacity = 64);
+
+	// returns true if the pair was not in the cache yet
+	bool Touch(GameObjectHandle a, GameObjectHandle b, uint32_t frame);
+
+	// removes every pair not touched on the given frame, passing each to func first
+	template <class Func>
+	void RemoveStale(uint32_t frame, Func func);
+
+	void Clear();
+
+	uint32_t Size() const { return mCount; }
+
+private:
+	static uint64_t MakeKey(GameObjectHandle a, GameObjectHandle b);
+	static uint32_t Hash(uint64_t key);
+
+	void Grow();
+	void RemoveAt(uint32_t index);
+
+	std::vector<Pair> mSlots;
+	uint32_t mMask;
+	uint32_t mCount;
+
+}; // class PairCache
+
+template <class Func>
+void PairCache::RemoveStale(uint32_t frame, Func func)
+{
+	uint32_t index = 0;
+	while (index < mSlots.size())
+	{
+		Pair& pair = mSlots[index];
+		if (pair.key != 0 && pair.frame != frame)
+		{
+			func(pair);
+			// the back shift may move an unvisited entry into this slot
+			RemoveAt(index);
+		}
+		else
+		{
+			++index;
+		}
+	}
+}
+
+} // namespace GameEngine
\ No newline at end of file
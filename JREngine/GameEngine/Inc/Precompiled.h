@@ -2,4 +2,4 @@
 
 #include "Common.h"
 
-#include <TinyXML\Inc\tinyxml.h>
\ No newline at end of file
+#include <TinyXML/Inc/tinyxml.h>
\ No newline at end of file
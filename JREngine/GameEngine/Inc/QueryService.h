@@ -0,0 +1,74 @@
+#pragma once
+
+#include "DynamicAABBTree.h"
+#include "GameObject.h"
+#include "Service.h"
+
+#include <Core/Inc/RTTI.h>
+
+namespace GameEngine
+{
+
+class AABoxColliderComponent;
+
+/*
+Spatial queries against collider bounds: raycasts, box and sphere overlaps and
+nearest neighbours. Every AABoxColliderComponent registers itself and keeps a
+proxy in a DynamicAABBTree that is refreshed once per frame in the physics
+phase, so queries cost a tree walk instead of a pass over every collider.
+
+The tree only narrows down candidates, each one is tested against the
+collider's current world box. An object moved since the last refresh can
+still be missed if it left its fat box; queries made after physics see
+everything in place.
+*/
+class QueryService : public Service
+{
+public:
+	struct RaycastHit
+	{
+		GameObjectHandle object;
+		AABoxColliderComponent* collider = nullptr;
+		float distance = 0.0f; // along the normalized ray direction, 0 when the origin is inside
+		Math::Vector3 point;
+	};
+
+	REGISTER_TYPE(QRSV) // (Q)ue(R)y(S)er(V)ice
+
+	QueryService();
+	~QueryService() override;
+
+	QueryService(const QueryService&) = delete;
+	QueryService& operator=(const QueryService&) = delete;
+
+	void Terminate() override;
+
+	void Update(float dTime) override;
+
+	void Register(AABoxColliderComponent* component);
+	void Unregister(AABoxColliderComponent* component);
+
+	// closest hit within maxDistance, the ray direction does not have to be
+	// normalized (e.g. Graphics::Camera::ScreenPointToRay for picking)
+	bool Raycast(const Math::Ray& ray, float maxDistance, RaycastHit& hit) const;
+	// appends every hit within maxDistance sorted near to far, returns the number added
+	uint32_t RaycastAll(const Math::Ray& ray, float maxDistance, std::vector<RaycastHit>& hits) const;
+
+	// append the objects whose collider touches the volume, return the number added
+	uint32_t OverlapBox(const Math::AABB& aabb, std::vector<GameObjectHandle>& handles) const;
+	uint32_t OverlapSphere(const Math::Sphere& sphere, std::vector<GameObjectHandle>& handles) const;
+
+	// appends up to count objects nearest to point, measured to the collider
+	// box and sorted near to far, skipping any further than maxDistance
+	uint32_t FindNearest(const Math::Vector3& point, uint32_t count, std::vector<GameObjectHandle>& handles, float maxDistance = (std::numeric_limits<float>::max)()) const;
+
+	uint32_t GetColliderCount() const { return static_cast<uint32_t>(mColliders.size()); }
+	const DynamicAABBTree& GetTree() const { return mTree; }
+
+private:
+	DynamicAABBTree mTree;
+	std::vector<AABoxColliderComponent*> mColliders; // indexed by AABoxColliderComponent::mQueryIndex
+
+}; // class QueryService
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "RenderPacket.h"
+
+namespace GameEngine
+{
+
+/*
+Draws RenderPackets. Render runs on the RenderPipeline's render thread, or on
+the thread calling World::Render when the pipeline is not threaded, and only
+ever sees one packet at a time.
+*/
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	virtual void Render(const RenderPacket& packet) = 0;
+
+}; // class RenderBackend
+
+// Draws nothing and counts what it was given, for tests and machines without
+// a GPU. Render commands still run. Read the stats after RenderPipeline::Flush.
+class NullRenderBackend : public RenderBackend
+{
+public:
+	struct Stats
+	{
+		uint32_t packets = 0;
+		uint32_t items = 0; // totals over every packet
+		uint32_t boxes = 0;
+		uint32_t lines = 0;
+		uint32_t commands = 0;
+		uint32_t lastFrame = 0;
+	};
+
+	void Render(const RenderPacket& packet) override;
+
+	const Stats& GetStats() const { return mStats; }
+	void ResetStats() { mStats = Stats(); }
+
+private:
+	Stats mStats;
+
+}; // class NullRenderBackend
+
+#if !defined(CORE_HEADLESS)
+// Debug boxes, lines and the grid through SimpleDraw. Items need a backend
+// that owns the meshes and materials their IDs refer to.
+class GraphicsRenderBackend : public RenderBackend
+{
+public:
+	void Render(const RenderPacket& packet) override;
+
+}; // class GraphicsRenderBackend
+#endif // #if !defined(CORE_HEADLESS)
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Common.h"
+
+namespace GameEngine
+{
+
+// one drawable, mesh and material are IDs the backend resolves
+struct RenderItem
+{
+	Math::Matrix4 world;
+	uint32_t meshId = 0;
+	uint32_t materialId = 0;
+};
+
+struct DebugBox
+{
+	Math::AABB aabb;
+	Math::Vector4 color;
+};
+
+struct DebugLine
+{
+	Math::Vector3 from;
+	Math::Vector3 to;
+	Math::Vector4 color;
+};
+
+// what one extraction job writes, see Component::Extract
+struct RenderList
+{
+	std::vector<RenderItem> items;
+	std::vector<DebugBox> boxes;
+	std::vector<DebugLine> lines;
+
+	void Clear()
+	{
+		items.clear();
+		boxes.clear();
+		lines.clear();
+	}
+};
+
+/*
+Copy of everything a frame draws, filled by World::Render and handed to a
+RenderBackend through the RenderPipeline. Holds no pointers into the World,
+so the render side can read it while the next update runs. Each extraction
+job writes its own list; lists and their vectors are kept between frames so
+a warmed up packet does not allocate.
+*/
+using RenderCommand = std::function<void()>;
+
+struct RenderPacket
+{
+	uint32_t frame = 0; // TickScheduler frame the packet was extracted on
+	bool bHasView = false; // nothing is drawn without a view
+	bool bDrawGrid = false;
+	Math::Matrix4 view;
+	Math::Matrix4 projection;
+	std::vector<RenderList> lists; // only the first listCount are in use
+	uint32_t listCount = 0;
+	// app graphics work posted through World::PostRenderCommand, run in order
+	// before the frame is flushed
+	std::vector<RenderCommand> commands;
+
+	// clears the packet for count lists
+	void Reset(uint32_t count);
+
+	uint32_t GetItemCount() const;
+	uint32_t GetBoxCount() const;
+	uint32_t GetLineCount() const;
+};
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace GameEngine
+{
+
+/*
+Double buffered hand-off between simulation and rendering. The simulation
+thread fills one packet (BeginPacket, then Submit) while the render thread
+draws the other, so frame N is submitted to the backend while frame N+1
+updates. BeginPacket only blocks when the render side is still busy with
+the packet it is about to reuse, i.e. when rendering is more than a frame
+behind.
+
+Unthreaded, Submit renders the packet right away on the calling thread. This
+is the default. The render thread is an opt-in: once it runs, the backend
+owns the GraphicsSystem and SimpleDraw, so the app must post any other
+graphics work (2D, debug draws, device changes) through the packet, see
+World::PostRenderCommand.
+*/
+class RenderPipeline
+{
+public:
+	RenderPipeline();
+	~RenderPipeline();
+
+	RenderPipeline(const RenderPipeline&) = delete;
+	RenderPipeline& operator=(const RenderPipeline&) = delete;
+
+	// waits for the render side to go idle first; no backend drops packets
+	void SetBackend(std::unique_ptr<RenderBackend> backend);
+	RenderBackend* GetBackend() const { return mBackend.get(); }
+
+	// starts or stops the render thread, off by default
+	void SetThreaded(bool threaded);
+	bool IsThreaded() const { return mThread.joinable(); }
+
+	// packet to fill for the next Submit
+	RenderPacket& BeginPacket();
+	// hands the packet from BeginPacket to the render side
+	void Submit();
+	// waits until every submitted packet has been rendered
+	void Flush();
+
+	// packets the backend has finished
+	uint64_t GetRenderedCount() const;
+
+private:
+	static const int kNone = -1;
+
+	void RenderLoop();
+	void StopThread();
+
+	std::unique_ptr<RenderBackend> mBackend;
+	RenderPacket mPackets[2];
+	int mWriteIndex; // packet the simulation fills
+
+	std::thread mThread;
+	mutable std::mutex mMutex;
+	std::condition_variable mWake; // render thread waits for work
+	std::condition_variable mDone; // simulation waits for a packet to free up
+
+	// guarded by mMutex
+	int mPendingIndex; // submitted and not picked up yet
+	int mRenderingIndex; // being drawn by the render thread
+	uint64_t mRenderedCount;
+	bool bQuit;
+
+}; // class RenderPipeline
+
+} // namespace GameEngine
\ No newline at end of file
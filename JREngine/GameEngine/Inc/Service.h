@@ -1,10 +1,13 @@
 #pragma once
 
-#include <Core\Inc\RTTI.h>
+#include "UpdateDesc.h"
+
+#include <Core/Inc/RTTI.h>
 
 namespace GameEngine
 {
 
+struct RenderList;
 class World;
 
 class Service
@@ -12,11 +15,13 @@ class Service
 protected:
 	friend class World;
 	World* mWorld;
+	// services default to running alone after the component passes
+	UpdateDesc mUpdateDesc;
 
 public:
 	REGISTER_TYPE(BSES) // (B)a(seS)ervice
 
-	Service() : mWorld{ nullptr } {}
+	Service() : mWorld{ nullptr }, mUpdateDesc{ UpdateDesc(UpdatePhase::Late).Exclusive() } {}
 	virtual ~Service() {}
 
 	Service(const Service&) = delete;
@@ -26,9 +31,12 @@ public:
 	virtual void Terminate() {}
 
 	virtual void Update(float dTime) {}
-	virtual void Render() {}
+	// adds debug drawing to the frame's render packet, runs on the main thread
+	virtual void Extract(RenderList& list) {}
 	virtual void Render2D() {}
 
+	const UpdateDesc& GetUpdateDesc() const { return mUpdateDesc; }
+
 	World& GetOwner() { return *mWorld; }
 	const World& GetOwner() const { return *mWorld; }
 
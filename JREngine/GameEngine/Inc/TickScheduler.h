@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Common.h"
+
+namespace GameEngine
+{
+
+class Component;
+
+// objects at least distance away from the origin update every interval frames
+struct TickBand
+{
+	float distance;
+	uint32_t interval;
+};
+
+/*
+Frame counter and distance bands behind reduced component tick rates (see
+Component::SetTickInterval). Components that tick by distance are kept in a
+list and re-banded on the main thread at the start of each World::Update, an
+eighth of the list per frame, so the update passes only compare counters.
+
+The origin follows the World's render camera; without one it stays where
+SetOrigin put it, e.g. at the player on a server.
+*/
+class TickScheduler
+{
+public:
+	// frames it takes to re-band every distance ticked component once
+	static const uint32_t kRebandFrames = 8;
+
+	TickScheduler();
+
+	TickScheduler(const TickScheduler&) = delete;
+	TickScheduler& operator=(const TickScheduler&) = delete;
+
+	// advances the frame and re-bands the next slice, called by World::Update
+	void BeginFrame();
+
+	void SetOrigin(const Math::Vector3& origin) { mOrigin = origin; }
+	const Math::Vector3& GetOrigin() const { return mOrigin; }
+
+	// bands are sorted by distance, anything closer than the first one
+	// ticks every frame; no bands means every frame everywhere
+	void SetBands(std::vector<TickBand> bands);
+	const std::vector<TickBand>& GetBands() const { return mBands; }
+
+	uint32_t GetFrame() const { return mFrame; }
+	uint32_t GetDistanceTickedCount() const { return static_cast<uint32_t>(mByDistance.size()); }
+
+	void AddByDistance(Component* component);
+	void RemoveByDistance(Component* component);
+
+private:
+	void Reband(Component* component) const;
+
+	std::vector<TickBand> mBands;
+	std::vector<Component*> mByDistance;
+	Math::Vector3 mOrigin;
+	uint32_t mFrame;
+
+}; // class TickScheduler
+
+} // namespace GameEngine
\ No newline at end of file
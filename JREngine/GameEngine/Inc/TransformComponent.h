@@ -2,29 +2,98 @@
 
 #include "Component.h"
 
+#include <atomic>
+
 namespace GameEngine
 {
 
+/*
+Position, rotation and scale relative to an optional parent transform. The
+local and world matrices are cached and only rebuilt after something they
+depend on changed: setters flag the transform, parenting flags the whole
+subtree. TransformService refreshes every flagged world matrix once per frame,
+reads in between rebuild on demand. That rebuild takes a lock per transform,
+so passes that only read transforms may call the getters from any thread.
+
+Setters and parenting touch the flags of child objects, so objects in one
+hierarchy must not be moved from different threads at the same time.
+*/
 class TransformComponent : public Component
 {
+	friend class TransformService;
+	static const uint32_t kNoIndex = 0xffffffff;
+
 	Math::Vector3 mPosition;
-	Math::Vector3 mForward;
+	Math::Quaternion mRotation;
+	Math::Vector3 mScale;
+
+	mutable Math::Matrix4 mLocal;
+	mutable Math::Matrix4 mWorld;
+	mutable std::atomic<bool> bLocalDirty;
+	mutable std::atomic<bool> bWorldDirty; // set on a transform implies set on all its children
+
+	TransformComponent* mParent;
+	std::vector<TransformComponent*> mChildren;
+	uint32_t mDepth; // 0 for roots
+	uint32_t mServiceIndex; // slot in the TransformService array
 
 public:
 	REGISTER_TYPE(TFMC); // (T)rans(f)or(m)(C)omponent
 
+	// fixed layout stored in cooked templates
+	struct Record
+	{
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+		float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		float scale[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
 	static void CreateFunc(GameObject* gameObj, const TiXmlNode* node);
+	static void CloneFunc(GameObject* gameObj, const Component* source);
+	static void CookFunc(const TiXmlNode* node, Record& record);
+	static void LoadFunc(GameObject* gameObj, const void* data, uint32_t size);
 
 	TransformComponent();
 	~TransformComponent() override;
 
-	Math::Matrix4 GetLocalToWorld() const;
+	void Initialize() override;
+	void Terminate() override;
+
+	// local values and the parent's handle
+	uint32_t GetSnapshotVersion() const override { return 1; }
+	void Serialize(SnapshotWriter& writer) const override;
+	void Deserialize(SnapshotReader& reader, uint32_t version) override;
 
-	void SetPosition(const Math::Vector3& pos) { mPosition = pos; }
-	void SetForward(const Math::Vector3& forward) { mForward = forward; }
+	// local values, relative to the parent
+	void SetPosition(const Math::Vector3& pos);
+	void SetRotation(const Math::Quaternion& rotation);
+	void SetScale(const Math::Vector3& scale);
+	// rotates to look along forward, keeping +y up
+	void SetForward(const Math::Vector3& forward);
 
 	const Math::Vector3& GetPosition() const { return mPosition; }
-	const Math::Vector3& GetForward() const { return mForward; }
+	const Math::Quaternion& GetRotation() const { return mRotation; }
+	const Math::Vector3& GetScale() const { return mScale; }
+	Math::Vector3 GetForward() const;
+
+	// keeps the local values, so the object follows its new parent from where
+	// it is relative to it; nullptr makes it a root again
+	void SetParent(TransformComponent* parent);
+	TransformComponent* GetParent() const { return mParent; }
+	const std::vector<TransformComponent*>& GetChildren() const { return mChildren; }
+	uint32_t GetDepth() const { return mDepth; }
+
+	const Math::Matrix4& GetLocalMatrix() const;
+	const Math::Matrix4& GetLocalToWorld() const;
+	Math::Vector3 GetWorldPosition() const { return Math::GetTranslation(GetLocalToWorld()); }
+
+private:
+	void MarkLocalDirty();
+	void MarkWorldDirty();
+	void SetDepth(uint32_t depth);
+	// without locking, for the service pass and callers holding the rebuild lock
+	void UpdateLocal() const;
+	void UpdateWorld() const;
 
 };
 
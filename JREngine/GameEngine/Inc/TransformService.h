@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Service.h"
+
+#include <Core/Inc/RTTI.h>
+
+namespace GameEngine
+{
+
+class TransformComponent;
+
+/*
+Keeps every TransformComponent in one array sorted by hierarchy depth, so a
+single front to back pass sees each parent before its children and can build
+world matrices as local * parent world. The array is only re-sorted after
+parenting changed; transforms that did not move are skipped by their flag.
+
+Runs at the start of the physics phase, before CollisionService reads the
+world matrices, once the gameplay passes moved things around.
+*/
+class TransformService : public Service
+{
+	using Transforms = std::vector<TransformComponent*>;
+
+	Transforms mTransforms; // nullptr once unregistered
+	uint32_t mRemovedCount;
+	uint32_t mUpdatedCount;
+	bool bOrderDirty;
+
+public:
+	REGISTER_TYPE(TFSV) // (T)rans(f)orm(S)er(V)ice
+
+	TransformService();
+	~TransformService() override;
+
+	TransformService(const TransformService&) = delete;
+	TransformService& operator=(const TransformService&) = delete;
+
+	void Terminate() override;
+
+	void Update(float dTime) override;
+
+	void Register(TransformComponent* component);
+	void Unregister(TransformComponent* component);
+	// call after a registered transform changed depth
+	void MarkOrderDirty() { bOrderDirty = true; }
+
+	uint32_t GetTransformCount() const { return static_cast<uint32_t>(mTransforms.size()) - mRemovedCount; }
+	// world matrices rebuilt by the last update
+	uint32_t GetUpdatedCount() const { return mUpdatedCount; }
+
+private:
+	void SortByDepth();
+
+}; // class TransformService
+
+} // namespace GameEngine
\ No newline at end of file
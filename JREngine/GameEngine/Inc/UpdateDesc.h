@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Core/Inc/RTTI.h>
+
+namespace GameEngine
+{
+
+class Component;
+
+// Order in which update passes run within World::Update
+enum class UpdatePhase : uint8_t
+{
+	PrePhysics,
+	Physics,
+	PostPhysics,
+	Late,
+	Count
+};
+
+/*
+Declares when an update pass runs and which component types it touches.
+Passes of the same phase run at the same time when neither writes a type
+the other reads or writes; otherwise they keep their registration order.
+Exclusive passes run alone on the main thread, use that for anything the
+masks cannot describe (globals, callbacks into game code, other objects).
+*/
+struct UpdateDesc
+{
+	UpdatePhase phase = UpdatePhase::PrePhysics;
+	uint64_t readMask = 0; // bit per ComponentTypeIndex
+	uint64_t writeMask = 0;
+	bool bExclusive = false;
+
+	UpdateDesc() = default;
+	explicit UpdateDesc(UpdatePhase updatePhase) : phase(updatePhase) {}
+
+	template <class... T>
+	UpdateDesc& Reads() { readMask |= MaskOf<T...>(); return *this; }
+	template <class... T>
+	UpdateDesc& Writes() { writeMask |= MaskOf<T...>(); return *this; }
+	UpdateDesc& Exclusive() { bExclusive = true; return *this; }
+
+	bool ConflictsWith(const UpdateDesc& other) const
+	{
+		return bExclusive || other.bExclusive ||
+			(writeMask & (other.readMask | other.writeMask)) != 0 ||
+			(readMask & other.writeMask) != 0;
+	}
+
+	template <class... T>
+	static uint64_t MaskOf()
+	{
+		uint64_t mask = 0;
+		using Expand = int[];
+		(void)Expand{ 0, (mask |= (uint64_t)1 << Core::TypeIndex<Component>::Get<T>(), 0)... };
+		return mask;
+	}
+};
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ComponentPool.h"
+#include "UpdateDesc.h"
+
+namespace Core { class JobSystem; }
+
+namespace GameEngine
+{
+
+/*
+Runs the World's update passes phase by phase. Within a phase, passes are
+grouped in registration order into batches that do not conflict (see
+UpdateDesc) and each batch is handed to the job system. Component pool
+passes are also cut into slot ranges so a single large pool spreads over
+every worker.
+*/
+class UpdateScheduler
+{
+public:
+	using UpdateFunc = std::function<void(float)>;
+
+	// slots per job when a pool pass is split
+	static const uint32_t kSlotsPerJob = 256;
+
+	UpdateScheduler();
+
+	// nullptr runs everything on the calling thread
+	void SetJobSystem(Core::JobSystem* jobSystem) { mJobSystem = jobSystem; }
+
+	void Clear();
+	void Add(const UpdateDesc& desc, UpdateFunc func);
+	// the pool's pass is split across threads when bSplit is set
+	void Add(ComponentPoolBase* pool, bool bSplit);
+
+	void Run(UpdatePhase phase, float dTime);
+
+	// true while worker threads may be running passes
+	bool IsRunningParallel() const { return bParallel; }
+
+private:
+	struct Pass
+	{
+		UpdateDesc desc;
+		UpdateFunc func;
+		ComponentPoolBase* pool = nullptr;
+		bool bSplit = false;
+	};
+
+	struct Job
+	{
+		const Pass* pass;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	void RunBatch(float dTime);
+
+	std::vector<Pass> mPasses[static_cast<size_t>(UpdatePhase::Count)];
+	std::vector<const Pass*> mBatch;
+	std::vector<Job> mJobs;
+	Core::JobSystem* mJobSystem;
+	bool bParallel;
+
+}; // class UpdateScheduler
+
+} // namespace GameEngine
\ No newline at end of file
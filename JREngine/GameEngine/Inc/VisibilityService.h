@@ -0,0 +1,80 @@
+#pragma once
+
+#include "DynamicAABBTree.h"
+#include "Service.h"
+
+#include <Core/Inc/RTTI.h>
+
+namespace GameEngine
+{
+
+class GameObject;
+
+/*
+Decides which objects World::Render draws. Objects whose components report
+bounds (Component::GetBounds) keep the box around all of them in a
+DynamicAABBTree, refreshed once per frame after physics. Cull walks the tree
+against the camera frustum; subtrees fully inside are accepted without testing
+their leaves. Objects without bounds cannot be placed and are always drawn,
+guessing a size would cull whatever they draw beyond it.
+*/
+class VisibilityService : public Service
+{
+public:
+	struct Stats
+	{
+		uint32_t tested = 0; // objects with bounds considered by the last cull
+		uint32_t culled = 0; // of those, found outside the frustum
+		uint32_t drawn = 0; // visible list size, including objects without bounds
+		uint32_t moved = 0; // tree reinsertions during the last update
+	};
+
+	REGISTER_TYPE(VISV) // (VI)sibility(S)er(V)ice
+
+	VisibilityService();
+	~VisibilityService() override;
+
+	VisibilityService(const VisibilityService&) = delete;
+	VisibilityService& operator=(const VisibilityService&) = delete;
+
+	void Terminate() override;
+
+	void Update(float dTime) override;
+
+	void Register(GameObject* gameObj);
+	void Unregister(GameObject* gameObj);
+
+	// fills the visible list for a world to clip space matrix
+	void Cull(const Math::Matrix4& viewProjection);
+	const std::vector<GameObject*>& GetVisible() const { return mVisible; }
+	const Stats& GetStats() const { return mStats; }
+
+	// splits the tree walk across the World's job system
+	void SetParallelCull(bool parallel) { bParallelCull = parallel; }
+
+	const DynamicAABBTree& GetTree() const { return mTree; }
+
+private:
+	struct Entry
+	{
+		GameObject* object;
+		int32_t proxy; // kNullNode when the object has no bounds
+		uint32_t unboundedIndex; // slot in mUnbounded otherwise
+	};
+
+	static bool GetBounds(const GameObject& gameObj, Math::AABB& aabb);
+	void AddUnbounded(Entry& entry);
+	void RemoveUnbounded(const Entry& entry);
+
+	DynamicAABBTree mTree;
+	std::vector<Entry> mEntries; // indexed by GameObject::mVisibilityIndex
+	std::vector<GameObject*> mUnbounded;
+	std::vector<GameObject*> mVisible;
+	std::vector<int32_t> mCullRoots;
+	std::vector<std::vector<GameObject*>> mJobVisible;
+	Stats mStats;
+	bool bParallelCull;
+
+}; // class VisibilityService
+
+} // namespace GameEngine
\ No newline at end of file
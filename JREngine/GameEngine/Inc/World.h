@@ -1,27 +1,87 @@
 #pragma once
 
+#include "ComponentPool.h"
 #include "GameObjectFactory.h"
+#include "LevelStreamer.h"
+#include "MessageBus.h"
+#include "RenderPipeline.h"
 #include "Service.h"
+#include "TickScheduler.h"
+#include "UpdateScheduler.h"
+#include "VisibilityService.h"
+#include "WorldProfiler.h"
+
+#include <mutex>
 
 namespace GameEngine
 {
 
 class World
 {
+	friend class GameObject;
+	friend class LevelStreamer;
+	friend class WorldSnapshot;
+
+	// slots per page for pools nobody reserved
+	static const uint32_t kDefaultComponentPageSize = 64;
+	// fewer visible objects than this per job are extracted on one thread
+	static const uint32_t kMinExtractPerJob = 256;
+
 	using GameObjectVector = std::vector<GameObject*>;
 	using ServiceVector = std::vector<std::unique_ptr<Service>>;
+	using ComponentPoolVector = std::vector<std::unique_ptr<ComponentPoolBase>>;
+	using NameIndex = std::unordered_map<uint32_t, GameObjectVector>; // name hash -> objects
+	using OnCreated = std::function<void(GameObjectHandle)>;
+	using BatchInitializer = std::function<void(uint32_t, GameObject&)>;
+
+	struct DeferredCreate
+	{
+		std::string templateFileName;
+		std::string name;
+		OnCreated onCreated;
+	};
 
 	std::unique_ptr<GameObjectAllocator> mGameObjectAllocator;
 	std::unique_ptr<GameObjectFactory> mGameObjectFactory;
 	std::unique_ptr<GameObjectHandlePool> mGameObjectHandlePool;
+	std::unique_ptr<LevelStreamer> mLevelStreamer;
+	std::unique_ptr<Core::JobSystem> mJobSystem;
+	UpdateScheduler mScheduler;
+	TickScheduler mTickScheduler;
+	WorldProfiler mProfiler;
+	RenderPipeline mRenderPipeline;
+	std::vector<RenderCommand> mRenderCommands; // posted for the next Render
+	MessageBus mMessageBus;
 
 	GameObjectVector mUpdateList;
 	GameObjectVector mDestroyList;
 	ServiceVector mServices;
+	ComponentPoolVector mComponentPools; // indexed by ComponentTypeIndex
+	NameIndex mNameIndex;
+	VisibilityService* mVisibilityService = nullptr;
+	GameObjectHandle mRenderCamera;
+	Math::Matrix4 mRenderView;
+	Math::Matrix4 mRenderProjection;
+	bool bHasRenderView = false;
+	bool bParallelExtract = true;
+	bool bDrawGrid = true;
 	bool bUpdating = false;
+	bool bScheduleDirty = true;
+
+	// requests made from worker threads, applied at the next phase boundary
+	std::mutex mDeferredMutex;
+	std::vector<GameObjectHandle> mDeferredDestroys;
+	std::vector<DeferredCreate> mDeferredCreates;
+
+	GameObjectVector mBatchObjects; // scratch for CreateBatch
+
+	// template file of every object, lets a WorldSnapshot recreate it
+	std::vector<std::string> mTemplateNames;
+	std::unordered_map<uint32_t, uint32_t> mTemplateIds; // name hash -> index into mTemplateNames
 
 public:
 	using Visitor = std::function<void(GameObject*)>;
+	using Predicate = std::function<bool(GameObject*)>;
 	using OnRegisterComponent = std::function<void()>;
 
 	World();
@@ -30,14 +90,76 @@ public:
 	void Initialize(uint32_t capacity, OnRegisterComponent registerComponentCB = []() {});
 	void Terminate();
 
+	// threads besides the caller that run update passes, 0 keeps Update single threaded
+	void SetWorkerCount(uint32_t workerCount);
+	Core::JobSystem& GetJobSystem() { return *mJobSystem; }
+
+	// loads an XML level, or a cooked one when the file has Cooked::kExtension
 	void LoadLevel(const char* levelFileName);
+	// loads and unloads levels in the background over several frames
+	LevelStreamer& GetLevelStreamer() { return *mLevelStreamer; }
 
+	// not allowed from inside a parallel update pass, use CreateDeferred there
 	GameObjectHandle Create(const char* templateFileName, const char* name);
-	GameObjectHandle Find(const char* name);
+	// safe from any update pass, the object is created at the end of the
+	// current update phase (right away outside of Update)
+	void CreateDeferred(const char* templateFileName, const char* name, OnCreated onCreated = nullptr);
+	// Spawns count objects from one template, appending their handles and
+	// returning how many were created. initializer(i, object) runs for each
+	// before its components are initialized, use it for per-instance values
+	// such as positions taken from an array. It must not add or remove components.
+	uint32_t CreateBatch(const char* templateFileName, const char* name, uint32_t count, std::vector<GameObjectHandle>& handles, const BatchInitializer& initializer = nullptr);
+	// templates are parsed on first use and cached, preloading moves that cost
+	// out of gameplay; reload after editing a template file on disk
+	bool PreloadTemplate(const char* templateFileName) { return mGameObjectFactory->Preload(templateFileName); }
+	void ReloadTemplate(const char* templateFileName) { mGameObjectFactory->Invalidate(templateFileName); }
+	void ReloadAllTemplates() { mGameObjectFactory->InvalidateAll(); }
+	// returns one of the live objects with this name, names need not be unique
+	GameObjectHandle Find(const char* name) const;
+	// appends every live object with this name, returns how many were found
+	uint32_t FindAll(const char* name, std::vector<GameObjectHandle>& handles) const;
+	// safe from any update pass, the object goes at the end of the current phase
 	void Destroy(GameObjectHandle gameObj);
+	// destroys every object the predicate returns true for, in a single pass
+	// over the update list, returns how many were destroyed
+	uint32_t DestroyAll(const Predicate& predicate);
 
 	void Visit(Visitor& visitor);
 
+	// object whose CameraComponent Render draws from, defaults to the first
+	// object created with a CameraComponent
+	void SetRenderCamera(GameObjectHandle handle) { mRenderCamera = handle; }
+	GameObjectHandle GetRenderCamera() const { return mRenderCamera; }
+	// view for worlds without a render camera, e.g. headless ones
+	void SetRenderView(const Math::Matrix4& view, const Math::Matrix4& projection);
+	// Render only draws what the VisibilityService finds in the camera frustum
+	VisibilityService& GetVisibilityService() { return *mVisibilityService; }
+	void SetDebugGridVisible(bool visible) { bDrawGrid = visible; }
+
+	// Render copies the visible objects' render state into a packet, split
+	// across the job system, and submits it to the pipeline's backend.
+	// Initialize picks the GraphicsRenderBackend, or a NullRenderBackend when
+	// headless, and leaves the pipeline unthreaded. With the render thread
+	// turned on, the backend draws while the next Update runs and every other
+	// GraphicsSystem or SimpleDraw call must go through PostRenderCommand.
+	RenderPipeline& GetRenderPipeline() { return mRenderPipeline; }
+	// runs command on the render side with the next Render's packet, after
+	// the packet's own draws and before the SimpleDraw flush
+	void PostRenderCommand(RenderCommand command) { mRenderCommands.push_back(std::move(command)); }
+	void SetParallelExtract(bool parallel) { bParallelExtract = parallel; }
+
+	// frame counter and distance bands for reduced component tick rates
+	TickScheduler& GetTickScheduler() { return mTickScheduler; }
+	const TickScheduler& GetTickScheduler() const { return mTickScheduler; }
+
+	// messages published during a phase are delivered when it ends,
+	// before the deferred destroys and creates are applied
+	MessageBus& GetMessageBus() { return mMessageBus; }
+
+	// per component type and per service timings, off until enabled
+	WorldProfiler& GetProfiler() { return mProfiler; }
+	const WorldProfiler& GetProfiler() const { return mProfiler; }
+
 	void Update(float deltaTime);
 	void Render();
 	void Render2D();
@@ -51,9 +173,37 @@ public:
 	template <class T>
 	const T* GetService() const;
 
+	// Every component type gets a pool the first time an object in this world
+	// adds one, growing by kDefaultComponentPageSize slots at a time.
+	// ReserveComponents sizes the pool up front for types spawned in bulk.
+	template <class T>
+	ComponentPool<T>* ReserveComponents(uint32_t capacity);
+
+	// Also moves the type's update into one pass per type instead of per
+	// object, scheduled by the desc (the pass always writes T).
+	template <class T>
+	ComponentPool<T>* RegisterComponentPool(uint32_t capacity, UpdateDesc desc = UpdateDesc());
+
+	template <class T>
+	ComponentPool<T>* GetComponentPool();
+	ComponentPoolBase* GetComponentPool(uint32_t typeIndex) const;
+
 private:
 	void DestroyInternal(GameObject* gameObj);
+	void ReleaseObject(GameObject* gameObj);
+	GameObjectHandle Spawn(const LevelEntry& entry);
+	// sets up a new object whose handle is already assigned
+	void AddObject(GameObject* object, uint32_t templateId, const char* name);
+	// brings an object back under a handle it had before, false if it cannot be created
+	bool Recreate(const char* templateFileName, const char* name, GameObjectHandle handle);
+	uint32_t GetTemplateId(const char* templateFileName);
+	void SetSpawnPosition(GameObject* gameObj, const Math::Vector3& position);
+	void RemoveFromNameIndex(GameObject* gameObj);
 	void PruneDestroyed();
+	void RebuildSchedule();
+	void Extract(RenderPacket& packet);
+	ComponentPoolBase* GetOrAddComponentPool(uint32_t typeIndex, ComponentPoolFactory factory, uint32_t pageSize = kDefaultComponentPageSize);
+	void FlushDeferred();
 
 }; // class World
 
@@ -65,14 +215,42 @@ World::AddService()
 	mServices.emplace_back(std::make_unique<T>());
 	auto& newServ = mServices.back();
 	newServ->mWorld = this;
-	return static_cast<T*>(newComp.get());
+	mProfiler.RegisterService(static_cast<uint32_t>(mServices.size() - 1), newServ->GetType());
+	bScheduleDirty = true;
+	return static_cast<T*>(newServ.get());
+}
+
+template <class T>
+ComponentPool<T>* World::ReserveComponents(uint32_t capacity)
+{
+	// a pool created here uses the hint as its page size, so it grows in steps of the same size
+	ComponentPoolBase* pool = GetOrAddComponentPool(ComponentTypeIndex::Get<T>(), &MakeComponentPool<T>, capacity);
+	pool->Reserve(capacity);
+	return static_cast<ComponentPool<T>*>(pool);
+}
+
+template <class T>
+ComponentPool<T>* World::RegisterComponentPool(uint32_t capacity, UpdateDesc desc)
+{
+	ComponentPool<T>* pool = ReserveComponents<T>(capacity);
+	ASSERT(!pool->IsScheduled(), "[World] Component pool already registered.");
+	desc.writeMask |= UpdateDesc::MaskOf<T>();
+	pool->SetUpdateDesc(desc);
+	bScheduleDirty = true;
+	return pool;
+}
+
+template <class T>
+ComponentPool<T>* World::GetComponentPool()
+{
+	return static_cast<ComponentPool<T>*>(GetComponentPool(ComponentTypeIndex::Get<T>()));
 }
 
 template <class T>
 T* World::GetService()
 {
 	// use const Get and const cast it to return
-	return const_cast<T*>(static_cast<const World*>(this)->GetComponent<T>());
+	return const_cast<T*>(static_cast<const World*>(this)->GetService<T>());
 }
 
 template <class T>
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <deque>
+
+namespace GameEngine
+{
+
+enum class ProfileStage
+{
+	Update,
+	Render, // extraction into the render packet
+	Render2D,
+	Count
+};
+
+/*
+Call counts and time spent per component type and per service, split by
+Update, Render and Render2D. Off by default; while off each instrumented
+call only checks a flag. Counters are atomic since pool passes and services
+run on worker threads, and keep adding up until Reset, or until the periodic
+report logs them and starts over.
+
+Components are timed one call at a time when they update with their object,
+and one slot range at a time when their pool runs its own pass.
+*/
+class WorldProfiler
+{
+public:
+	static const uint32_t kMaxComponentTypes = 64;
+	static const size_t kStageCount = static_cast<size_t>(ProfileStage::Count);
+
+	struct Record
+	{
+		char name[5]; // REGISTER_TYPE id
+		bool bService;
+		uint64_t calls[kStageCount];
+		double milliseconds[kStageCount];
+
+		double GetTotalMilliseconds() const;
+	};
+
+	// steady clock in nanoseconds
+	static int64_t Now();
+
+	WorldProfiler();
+
+	WorldProfiler(const WorldProfiler&) = delete;
+	WorldProfiler& operator=(const WorldProfiler&) = delete;
+
+	void SetEnabled(bool enabled) { bEnabled = enabled; }
+	bool IsEnabled() const { return bEnabled; }
+
+	// logs the table every frames updates and resets, 0 only logs on request
+	void SetReportInterval(uint32_t frames) { mReportInterval = frames; }
+
+	void RegisterComponentType(uint32_t typeIndex, int type);
+	void RegisterService(uint32_t serviceIndex, int type);
+
+	void AddComponent(ProfileStage stage, uint32_t typeIndex, uint32_t calls, int64_t nanoseconds);
+	void AddService(ProfileStage stage, uint32_t serviceIndex, int64_t nanoseconds);
+
+	// run func, timed when profiling is on
+	template <class Func>
+	void TimeComponent(ProfileStage stage, uint32_t typeIndex, Func func);
+	template <class Func>
+	void TimeService(ProfileStage stage, uint32_t serviceIndex, Func func);
+
+	// counts the frame, called at the end of World::Update
+	void EndFrame();
+
+	// every type and service with calls since the last reset, slowest first
+	void GetRecords(std::vector<Record>& records) const;
+	uint32_t GetFrameCount() const { return mFrameCount; }
+
+	void LogReport() const;
+	void Reset();
+
+private:
+	struct Counters
+	{
+		int type = 0;
+		std::atomic<uint64_t> calls[kStageCount];
+		std::atomic<int64_t> nanoseconds[kStageCount];
+
+		Counters();
+		void Reset();
+	};
+
+	void AddRecord(const Counters& counters, bool bService, std::vector<Record>& records) const;
+
+	Counters mComponents[kMaxComponentTypes]; // indexed by ComponentTypeIndex
+	std::deque<Counters> mServices; // indexed like World::mServices, a deque keeps the atomics in place
+	uint32_t mFrameCount;
+	uint32_t mReportInterval;
+	bool bEnabled;
+
+}; // class WorldProfiler
+
+template <class Func>
+void WorldProfiler::TimeComponent(ProfileStage stage, uint32_t typeIndex, Func func)
+{
+	if (!bEnabled)
+	{
+		func();
+		return;
+	}
+	const int64_t start = Now();
+	func();
+	AddComponent(stage, typeIndex, 1, Now() - start);
+}
+
+template <class Func>
+void WorldProfiler::TimeService(ProfileStage stage, uint32_t serviceIndex, Func func)
+{
+	if (!bEnabled)
+	{
+		func();
+		return;
+	}
+	const int64_t start = Now();
+	func();
+	AddService(stage, serviceIndex, Now() - start);
+}
+
+} // namespace GameEngine
\ No newline at end of file
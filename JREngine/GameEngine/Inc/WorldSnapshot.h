@@ -0,0 +1,194 @@
+#pragma once
+
+#include "GameObject.h"
+
+namespace GameEngine
+{
+
+class World;
+
+// Appends a component's state to a snapshot, see Component::Serialize
+class SnapshotWriter
+{
+public:
+	SnapshotWriter(std::vector<uint8_t>& buffer) : mBuffer(buffer) {}
+
+	void Write(const void* data, uint32_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+	}
+
+	template <class T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "[SnapshotWriter] Only plain values can be written directly.");
+		Write(&value, sizeof(T));
+	}
+
+	// stores the handle's id, objects recreated by a restore keep their handles
+	void WriteHandle(GameObjectHandle handle) { Write(handle.GetId()); }
+
+private:
+	std::vector<uint8_t>& mBuffer;
+};
+
+// Reads back what the matching Serialize wrote, see Component::Deserialize
+class SnapshotReader
+{
+public:
+	SnapshotReader(const uint8_t* data, uint32_t size) : mCursor(data), mEnd(data + size) {}
+
+	void Read(void* data, uint32_t size)
+	{
+		ASSERT(size <= GetRemaining(), "[SnapshotReader] Read past the end of the component data.");
+		std::memcpy(data, mCursor, size);
+		mCursor += size;
+	}
+
+	template <class T>
+	void Read(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "[SnapshotReader] Only plain values can be read directly.");
+		Read(&value, sizeof(T));
+	}
+
+	GameObjectHandle ReadHandle()
+	{
+		uint32_t id = 0;
+		Read(id);
+		return GameObjectHandle::FromId(id);
+	}
+
+	uint32_t GetRemaining() const { return static_cast<uint32_t>(mEnd - mCursor); }
+
+private:
+	const uint8_t* mCursor;
+	const uint8_t* mEnd;
+};
+
+/*
+Binary copy of a World's objects and component state, cheap enough to take
+every frame for rollback and replays. Capture walks the live objects and
+appends each component's Serialize output to one buffer that is reused
+between captures, so capturing does not allocate once it has warmed up.
+
+Restore brings the World back to the captured state: objects created since
+are destroyed, destroyed ones are recreated from their template under their
+old handle, and every component reads its state back in place, so nothing
+is reallocated for objects that still exist. Components without Serialize
+hooks keep whatever state they have. Collision Enter/Exit events follow from
+the restored bounds on the next update.
+
+A delta capture only stores components whose bytes differ from a full
+baseline capture and needs that baseline to restore. Looking objects up in
+the baseline builds an index inside it, so one baseline must not be used by
+several threads at once.
+
+Layout, native endian and 4 byte aligned:
+
+	Header
+	objects  ObjectRecord, then ComponentRecord + payload per stored component
+	types    TypeRecord per component type, Component::GetType and version
+	strings  object and template names, NUL terminated
+*/
+class WorldSnapshot
+{
+public:
+	static const uint32_t kMagic = Core::MakeTypeId("JRSS");
+	static const uint16_t kVersion = 1;
+
+	WorldSnapshot();
+
+	void Capture(const World& world);
+	// baseline must be a full capture of the same World
+	void CaptureDelta(const World& world, const WorldSnapshot& baseline);
+
+	// baseline is the one the delta was captured against, unused for full
+	// snapshots; returns false if an object could not be recreated
+	bool Restore(World& world, const WorldSnapshot* baseline = nullptr) const;
+
+	// the serialized form, e.g. for a replay file
+	const std::vector<uint8_t>& GetData() const { return mData; }
+	// takes over data from GetData, false if it is not a valid snapshot
+	bool SetData(std::vector<uint8_t> data);
+
+	bool IsEmpty() const { return mData.empty(); }
+	bool IsDelta() const;
+	// unique per capture, deltas remember the id of their baseline
+	uint32_t GetId() const;
+	uint32_t GetObjectCount() const;
+	uint32_t GetSize() const { return static_cast<uint32_t>(mData.size()); }
+
+private:
+	static const uint32_t kNoString = 0xffffffff;
+	static const uint32_t kNotFound = 0xffffffff;
+
+	struct Header
+	{
+		enum Flags : uint16_t
+		{
+			kDelta = 1 << 0
+		};
+
+		uint32_t magic;
+		uint16_t version;
+		uint16_t flags;
+		uint32_t id;
+		uint32_t baselineId; // deltas only
+		uint32_t objectCount;
+		uint32_t typeCount;
+		uint32_t typeOffset;
+		uint32_t stringOffset;
+	};
+
+	struct ObjectRecord
+	{
+		uint32_t handle; // GameObjectHandle::GetId
+		uint32_t name; // string offset
+		uint32_t templateName; // string offset, kNoString if made without a template
+		uint32_t componentCount; // ComponentRecords that follow
+	};
+
+	struct ComponentRecord
+	{
+		uint32_t type; // index of the TypeRecord
+		uint32_t size; // payload bytes following this record, before padding
+	};
+
+	struct TypeRecord
+	{
+		int32_t type;
+		uint32_t version;
+	};
+
+	void CaptureInternal(const World& world, const WorldSnapshot* baseline);
+	uint32_t AddString(const char* str, uint32_t hash);
+	uint32_t AddType(const Component& component);
+
+	const Header& GetHeader() const { return *reinterpret_cast<const Header*>(mData.data()); }
+	const ObjectRecord& GetObject(uint32_t offset) const { return *reinterpret_cast<const ObjectRecord*>(&mData[offset]); }
+	const ComponentRecord& GetComponent(uint32_t offset) const { return *reinterpret_cast<const ComponentRecord*>(&mData[offset]); }
+	const TypeRecord& GetType(uint32_t index) const;
+	const char* GetString(uint32_t offset) const;
+	// offset of the next ObjectRecord
+	uint32_t SkipObject(uint32_t offset) const;
+	// offset of the object's ObjectRecord, kNotFound if it is not in the snapshot
+	uint32_t FindObject(uint32_t handleId) const;
+	// offset of the object's ComponentRecord for the type, kNotFound if not stored
+	uint32_t FindComponent(uint32_t objectOffset, int32_t type) const;
+	void ReadComponents(uint32_t objectOffset, GameObject& gameObj) const;
+
+	std::vector<uint8_t> mData;
+
+	// capture scratch, kept to reuse the memory
+	std::vector<char> mStrings;
+	std::vector<TypeRecord> mTypes;
+	std::unordered_map<uint32_t, uint32_t> mNameOffsets; // name hash -> string offset
+	std::vector<uint32_t> mTemplateOffsets; // template id -> string offset
+
+	mutable std::unordered_map<uint32_t, uint32_t> mObjectOffsets; // handle id -> offset, built on first lookup
+
+}; // class WorldSnapshot
+
+} // namespace GameEngine
\ No newline at end of file
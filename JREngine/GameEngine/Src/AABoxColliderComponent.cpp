@@ -3,19 +3,33 @@
 
 #include "CollisionService.h"
 #include "GameObject.h"
+#include "QueryService.h"
+#include "RenderPacket.h"
 #include "TransformComponent.h"
 #include "World.h"
-
-#include <Graphics\Inc\SimpleDraw.h>
-
-using namespace Graphics;
+#include "WorldSnapshot.h"
 
 namespace GameEngine
 {
 
 void AABoxColliderComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* node)
 {
-	AABoxColliderComponent* newComponent = gameObj->AddComponent<AABoxColliderComponent>();
+	Record record;
+	CookFunc(node, record);
+	LoadFunc(gameObj, &record, sizeof(record));
+}
+
+void AABoxColliderComponent::CloneFunc(GameObject* gameObj, const Component* source)
+{
+	auto newComponent = gameObj->AddComponent<AABoxColliderComponent>();
+	auto sourceComponent = static_cast<const AABoxColliderComponent*>(source);
+	newComponent->mCenter = sourceComponent->mCenter;
+	newComponent->mExtend = sourceComponent->mExtend;
+	newComponent->mColor = sourceComponent->mColor;
+}
+
+void AABoxColliderComponent::CookFunc(const TiXmlNode* node, Record& record)
+{
 	auto vec = node->FirstChildElement();
 	while (vec)
 	{
@@ -30,17 +44,23 @@ void AABoxColliderComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* no
 		// set dimensions of desired vector
 		if (std::strcmp(vec->FirstAttribute()->Value(), "Center") == 0)
 		{
-			newComponent->SetCenter({ x,y,z });
+			record.center[0] = x;
+			record.center[1] = y;
+			record.center[2] = z;
 		}
 		else if (std::strcmp(vec->FirstAttribute()->Value(), "Extend") == 0)
 		{
-			newComponent->SetExtend({ x,y,z });
+			record.extend[0] = x;
+			record.extend[1] = y;
+			record.extend[2] = z;
 		}
 		else if (std::strcmp(vec->FirstAttribute()->Value(), "Color") == 0)
 		{
 			dim = dim->NextSiblingElement();
-			float a = static_cast<float>(std::atof(dim->GetText()));
-			newComponent->SetColor({ x,y,z,a });
+			record.color[0] = x;
+			record.color[1] = y;
+			record.color[2] = z;
+			record.color[3] = static_cast<float>(std::atof(dim->GetText()));
 		}
 
 		// move to next vector
@@ -48,11 +68,32 @@ void AABoxColliderComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* no
 	}
 }
 
+void AABoxColliderComponent::LoadFunc(GameObject* gameObj, const void* data, uint32_t size)
+{
+	// a stale or corrupt file, adding nothing makes the loader drop the record
+	if (size != sizeof(Record))
+	{
+		LOG("[AABoxColliderComponent] Cooked record is %u bytes, expected %u.", size, static_cast<uint32_t>(sizeof(Record)));
+		return;
+	}
+	Record record;
+	std::memcpy(&record, data, sizeof(record));
+
+	auto newComponent = gameObj->AddComponent<AABoxColliderComponent>();
+	newComponent->SetCenter({ record.center[0], record.center[1], record.center[2] });
+	newComponent->SetExtend({ record.extend[0], record.extend[1], record.extend[2] });
+	newComponent->SetColor({ record.color[0], record.color[1], record.color[2], record.color[3] });
+}
+
 AABoxColliderComponent::AABoxColliderComponent()
 	: mTransformComponent(nullptr)
 	, mCenter(Math::Vector3::Zero())
 	, mExtend({1.0f,1.0f,1.0f})
 	, mColor(Math::Vector4::Green())
+	, mBroadphaseIndex(kNoProxy)
+	, mQueryProxy(DynamicAABBTree::kNullNode)
+	, mQueryIndex(0)
+	, bColliding(false)
 {
 }
 
@@ -65,41 +106,49 @@ void AABoxColliderComponent::Initialize()
 	mTransformComponent = GetOwner().GetComponent<TransformComponent>();
 	auto service = GetOwner().GetWorld().GetService<CollisionService>();
 	service->Register(this);
+	GetOwner().GetWorld().GetService<QueryService>()->Register(this);
 }
 
 void AABoxColliderComponent::Terminate()
 {
 	auto service = GetOwner().GetWorld().GetService<CollisionService>();
 	service->Unregister(this);
+	GetOwner().GetWorld().GetService<QueryService>()->Unregister(this);
 }
 
-void AABoxColliderComponent::Render()
+void AABoxColliderComponent::Extract(RenderList& list) const
 {
-	SimpleDraw::DrawAABB(GetAABB(), mColor);
+	list.boxes.push_back({ GetAABB(), bColliding ? Math::Vector4::Red() : mColor });
 }
 
-bool AABoxColliderComponent::CheckCollision(AABoxColliderComponent& boxB)
+void AABoxColliderComponent::Serialize(SnapshotWriter& writer) const
 {
-	float x1Max = mCenter.x + mExtend.x;
-	float x1Min = mCenter.x - mExtend.x;
-	float x2Max = boxB.mCenter.x + boxB.mExtend.x;
-	float x2Min = boxB.mCenter.x - boxB.mExtend.x;
-
-	float y1Max = mCenter.y + mExtend.y;
-	float y1Min = mCenter.y - mExtend.y;
-	float y2Max = boxB.mCenter.y + boxB.mExtend.y;
-	float y2Min = boxB.mCenter.y - boxB.mExtend.y;
+	writer.Write(mCenter);
+	writer.Write(mExtend);
+	writer.Write(mColor);
+	writer.Write(static_cast<uint32_t>(bColliding));
+}
 
-	float z1Max = mCenter.z + mExtend.z;
-	float z1Min = mCenter.z - mExtend.z;
-	float z2Max = boxB.mCenter.z + boxB.mExtend.z;
-	float z2Min = boxB.mCenter.z - boxB.mExtend.z;
+void AABoxColliderComponent::Deserialize(SnapshotReader& reader, uint32_t version)
+{
+	ASSERT(version == 1, "[AABoxColliderComponent] Unknown snapshot version.");
+	uint32_t colliding = 0;
+	reader.Read(mCenter);
+	reader.Read(mExtend);
+	reader.Read(mColor);
+	reader.Read(colliding);
+	bColliding = colliding != 0;
+}
 
-	if (x1Max < x2Min || x1Min > x2Max) return false;
-	if (y1Max < y2Min || y1Min > y2Max) return false;
-	if (z1Max < z2Min || z1Min > z2Max) return false;
+bool AABoxColliderComponent::CheckCollision(AABoxColliderComponent& boxB)
+{
+	// compare in world space
+	const Math::AABB a = GetAABB();
+	const Math::AABB b = boxB.GetAABB();
 
-	mColor = boxB.mColor = Math::Vector4::Red();
+	if (Math::Abs(a.center.x - b.center.x) > a.extend.x + b.extend.x) return false;
+	if (Math::Abs(a.center.y - b.center.y) > a.extend.y + b.extend.y) return false;
+	if (Math::Abs(a.center.z - b.center.z) > a.extend.z + b.extend.z) return false;
 
 	return true;
 }
@@ -124,7 +173,7 @@ void AABoxColliderComponent::AddCollisionEvent(CollisionEvent eventCall, Collisi
 
 void AABoxColliderComponent::OnCollision()
 {
-	for (auto e : mCollisionEvents)
+	for (const auto& e : mCollisionEvents)
 	{
 		e();
 	}
@@ -132,7 +181,7 @@ void AABoxColliderComponent::OnCollision()
 
 void AABoxColliderComponent::OnCollisionEnter()
 {
-	for (auto e : mCollisionEnterEvents)
+	for (const auto& e : mCollisionEnterEvents)
 	{
 		e();
 	}
@@ -140,16 +189,36 @@ void AABoxColliderComponent::OnCollisionEnter()
 
 void AABoxColliderComponent::OnCollisionExit()
 {
-	for (auto e : mCollisionExitEvents)
+	for (const auto& e : mCollisionExitEvents)
 	{
 		e();
 	}
 }
 
+bool AABoxColliderComponent::HasEvents(CollisionEventType eventType) const
+{
+	switch (eventType)
+	{
+	case CollisionEventType::Colliding: return !mCollisionEvents.empty();
+	case CollisionEventType::Enter: return !mCollisionEnterEvents.empty();
+	case CollisionEventType::Exit: return !mCollisionExitEvents.empty();
+	default: return false;
+	}
+}
+
 Math::AABB AABoxColliderComponent::GetAABB() const
 {
-	Math::Vector3 pos = mTransformComponent->GetPosition();
-	return Math::AABB(mCenter + pos, mExtend);
+	// box around the transformed box, the extents go through the absolute
+	// rotation and scale
+	const Math::Matrix4& world = mTransformComponent->GetLocalToWorld();
+	const Math::Vector3 center = Math::TransformCoord(mCenter, world);
+	const Math::Vector3 extend
+	(
+		Math::Abs(world._11) * mExtend.x + Math::Abs(world._21) * mExtend.y + Math::Abs(world._31) * mExtend.z,
+		Math::Abs(world._12) * mExtend.x + Math::Abs(world._22) * mExtend.y + Math::Abs(world._32) * mExtend.z,
+		Math::Abs(world._13) * mExtend.x + Math::Abs(world._23) * mExtend.y + Math::Abs(world._33) * mExtend.z
+	);
+	return Math::AABB(center, extend);
 }
 
 } // namespace GameEngine
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Precompiled.h"
+
+#if !defined(CORE_HEADLESS)
 #include "CameraComponent.h"
 
 #include "GameObject.h"
@@ -12,6 +14,17 @@ void CameraComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* node)
 	auto newComponent = gameObj->AddComponent<CameraComponent>();
 }
 
+void CameraComponent::CloneFunc(GameObject* gameObj, const Component* source)
+{
+	auto newComponent = gameObj->AddComponent<CameraComponent>();
+	newComponent->mCamera = static_cast<const CameraComponent*>(source)->mCamera;
+}
+
+void CameraComponent::LoadFunc(GameObject* gameObj, const void* data, uint32_t size)
+{
+	gameObj->AddComponent<CameraComponent>();
+}
+
 CameraComponent::CameraComponent()
 {
 }
@@ -20,4 +33,6 @@ CameraComponent::~CameraComponent()
 {
 }
 
-} // namespace GameEngine
\ No newline at end of file
+} // namespace GameEngine
+
+#endif // #if !defined(CORE_HEADLESS)
\ No newline at end of file
@@ -2,12 +2,19 @@
 #include "CollisionService.h"
 
 #include "AABoxColliderComponent.h"
+#include "World.h"
 
 namespace GameEngine
 {
 
 CollisionService::CollisionService()
+	: mFrame(0)
+	, mRemovedCount(0)
+	, mAddedCount(0)
+	, mPairCount(0)
 {
+	// collision callbacks run game code, so keep the pass to itself
+	mUpdateDesc = UpdateDesc(UpdatePhase::Physics).Exclusive();
 }
 
 CollisionService::~CollisionService()
@@ -20,39 +27,216 @@ void CollisionService::Initialize()
 
 void CollisionService::Terminate()
 {
+	for (auto& proxy : mProxies)
+	{
+		if (proxy.collider)
+		{
+			proxy.collider->mBroadphaseIndex = AABoxColliderComponent::kNoProxy;
+		}
+	}
+	mProxies.clear();
+	mRemovedCount = 0;
+	mAddedCount = 0;
+	mPairCache.Clear();
 }
 
 void CollisionService::Update(float dTime)
 {
-	for (auto comp1 : mSubscribers)
+	++mFrame;
+
+	RemoveUnregistered();
+	UpdateBounds();
+	SortProxies();
+	FindPairs();
+	FindExits();
+	DispatchEvents();
+}
+
+void CollisionService::FindPairs()
+{
+	// sweep along x, a proxy can only overlap the ones after it whose min x
+	// is not past its max x
+	mPairCount = 0;
+	MessageBus& messageBus = GetOwner().GetMessageBus();
+	const size_t count = mProxies.size();
+	for (size_t i = 0; i < count; ++i)
 	{
-		for (auto comp2 : mSubscribers)
+		const Proxy& a = mProxies[i];
+		for (size_t j = i + 1; j < count && mProxies[j].minX <= a.maxX; ++j)
 		{
-			if (comp1 == comp2)
+			const Proxy& b = mProxies[j];
+			if (a.maxY < b.minY || a.minY > b.maxY) continue;
+			if (a.maxZ < b.minZ || a.minZ > b.maxZ) continue;
+
+			AABoxColliderComponent* colliderA = a.collider;
+			AABoxColliderComponent* colliderB = b.collider;
+			colliderA->bColliding = true;
+			colliderB->bColliding = true;
+			++mPairCount;
+
+			// only queue colliders that actually listen for the event
+			const GameObjectHandle handleA = colliderA->GetOwner().GetHandle();
+			const GameObjectHandle handleB = colliderB->GetOwner().GetHandle();
+			if (mPairCache.Touch(handleA, handleB, mFrame))
 			{
-				continue;
+				// a new contact wakes sleeping objects on both sides
+				colliderA->GetOwner().Wake();
+				colliderB->GetOwner().Wake();
+				messageBus.Send(handleA, CollisionEnterMessage{ handleB });
+				messageBus.Send(handleB, CollisionEnterMessage{ handleA });
+				if (colliderA->HasEvents(AABoxColliderComponent::CollisionEventType::Enter)) mEnterEvents.push_back(colliderA);
+				if (colliderB->HasEvents(AABoxColliderComponent::CollisionEventType::Enter)) mEnterEvents.push_back(colliderB);
 			}
-			if (CheckCollision(comp1, comp2))
+			if (colliderA->HasEvents(AABoxColliderComponent::CollisionEventType::Colliding)) mCollidingEvents.push_back(colliderA);
+			if (colliderB->HasEvents(AABoxColliderComponent::CollisionEventType::Colliding)) mCollidingEvents.push_back(colliderB);
+		}
+	}
+}
+
+void CollisionService::FindExits()
+{
+	// pairs not seen this frame have separated, or one side was destroyed
+	// in which case only the survivor hears about it
+	MessageBus& messageBus = GetOwner().GetMessageBus();
+	mPairCache.RemoveStale(mFrame, [this, &messageBus](const PairCache::Pair& pair)
+	{
+		GameObjectHandle handles[] = { pair.objectA, pair.objectB };
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			const GameObjectHandle handle = handles[i];
+			GameObject* object = handle.Get();
+			if (object)
+			{
+				messageBus.Send(handle, CollisionExitMessage{ handles[1 - i] });
+			}
+			AABoxColliderComponent* collider = object ? object->GetComponent<AABoxColliderComponent>() : nullptr;
+			if (collider && collider->HasEvents(AABoxColliderComponent::CollisionEventType::Exit))
 			{
-				comp1->OnCollision();
-				comp2->OnCollision();
+				mExitEvents.push_back(collider);
 			}
 		}
+	});
+}
+
+void CollisionService::DispatchEvents()
+{
+	for (auto collider : mEnterEvents)
+	{
+		collider->OnCollisionEnter();
 	}
+	for (auto collider : mCollidingEvents)
+	{
+		collider->OnCollision();
+	}
+	for (auto collider : mExitEvents)
+	{
+		collider->OnCollisionExit();
+	}
+	mEnterEvents.clear();
+	mCollidingEvents.clear();
+	mExitEvents.clear();
 }
 
 void CollisionService::Register(AABoxColliderComponent* component)
 {
-	mSubscribers.push_back(component);
+	ASSERT(component->mBroadphaseIndex == AABoxColliderComponent::kNoProxy, "[CollisionService] Collider registered twice.");
+
+	// appended unsorted, the next update sorts it into place
+	component->mBroadphaseIndex = static_cast<uint32_t>(mProxies.size());
+	mProxies.push_back({ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, component });
+	++mAddedCount;
 }
 
 void CollisionService::Unregister(AABoxColliderComponent* component)
 {
-	auto findIter = std::find(mSubscribers.begin, mSubscribers.end, component);
-	if (findIter != mSubscribers.end)
+	const uint32_t index = component->mBroadphaseIndex;
+	if (index == AABoxColliderComponent::kNoProxy)
 	{
-		mSubscribers.erase(findIter);
+		return;
+	}
+
+	// leave a hole, removed in one pass at the start of the next update
+	ASSERT(mProxies[index].collider == component, "[CollisionService] Broadphase index out of sync.");
+	mProxies[index].collider = nullptr;
+	component->mBroadphaseIndex = AABoxColliderComponent::kNoProxy;
+	++mRemovedCount;
+}
+
+void CollisionService::RemoveUnregistered()
+{
+	if (mRemovedCount == 0)
+	{
+		return;
+	}
+
+	// stable compaction keeps the array sorted
+	uint32_t writeIndex = 0;
+	for (auto& proxy : mProxies)
+	{
+		if (proxy.collider)
+		{
+			proxy.collider->mBroadphaseIndex = writeIndex;
+			mProxies[writeIndex++] = proxy;
+		}
+	}
+	mProxies.resize(writeIndex);
+	mRemovedCount = 0;
+}
+
+void CollisionService::UpdateBounds()
+{
+	for (auto& proxy : mProxies)
+	{
+		const Math::AABB aabb = proxy.collider->GetAABB();
+		proxy.minX = aabb.center.x - aabb.extend.x;
+		proxy.maxX = aabb.center.x + aabb.extend.x;
+		proxy.minY = aabb.center.y - aabb.extend.y;
+		proxy.maxY = aabb.center.y + aabb.extend.y;
+		proxy.minZ = aabb.center.z - aabb.extend.z;
+		proxy.maxZ = aabb.center.z + aabb.extend.z;
+		proxy.collider->bColliding = false;
+	}
+}
+
+void CollisionService::SortProxies()
+{
+	const size_t count = mProxies.size();
+
+	// a big batch of new colliders (level load, mass spawn) is far from
+	// sorted, a full sort beats insertion sort there
+	const bool bFullSort = mAddedCount > 32 && mAddedCount * 8 > count;
+	mAddedCount = 0;
+	if (bFullSort)
+	{
+		std::sort(mProxies.begin(), mProxies.end(), [](const Proxy& a, const Proxy& b)
+		{
+			return a.minX < b.minX;
+		});
+		for (size_t i = 0; i < count; ++i)
+		{
+			mProxies[i].collider->mBroadphaseIndex = static_cast<uint32_t>(i);
+		}
+		return;
+	}
+
+	// insertion sort, close to linear as objects move little between frames
+	for (size_t i = 1; i < count; ++i)
+	{
+		if (mProxies[i - 1].minX <= mProxies[i].minX)
+		{
+			continue;
+		}
+
+		const Proxy key = mProxies[i];
+		size_t j = i;
+		for (; j > 0 && mProxies[j - 1].minX > key.minX; --j)
+		{
+			mProxies[j] = mProxies[j - 1];
+			mProxies[j].collider->mBroadphaseIndex = static_cast<uint32_t>(j);
+		}
+		mProxies[j] = key;
+		key.collider->mBroadphaseIndex = static_cast<uint32_t>(j);
 	}
 }
 
-}
\ No newline at end of file
+} // namespace GameEngine
\ No newline at end of file
@@ -1,7 +1,51 @@
 #include "Precompiled.h"
 #include "Component.h"
 
+#include "GameObject.h"
+#include "World.h"
+
 namespace GameEngine
 {
 
+namespace
+{
+	// round robin offsets spread components over the frames of their interval
+	std::atomic<uint32_t> sNextTickStagger{ 0 };
+}
+
+void Component::SetTickInterval(uint32_t interval)
+{
+	ASSERT(interval > 0 && interval <= 0xffff, "[Component] Tick interval out of range.");
+	if (IsTickByDistance())
+	{
+		SetTickByDistance(false);
+	}
+	if (interval > 1 && mTickInterval == 1)
+	{
+		mTickStagger = static_cast<uint16_t>(sNextTickStagger.fetch_add(1));
+	}
+	mTickInterval = static_cast<uint16_t>(interval);
+}
+
+void Component::SetTickByDistance(bool byDistance)
+{
+	ASSERT(mGameObject, "[Component] Component is not on an object.");
+	if (byDistance == IsTickByDistance())
+	{
+		return;
+	}
+
+	TickScheduler& scheduler = mGameObject->GetWorld().GetTickScheduler();
+	if (byDistance)
+	{
+		mTickStagger = static_cast<uint16_t>(sNextTickStagger.fetch_add(1));
+		scheduler.AddByDistance(this);
+	}
+	else
+	{
+		scheduler.RemoveByDistance(this);
+		mTickInterval = 1;
+	}
+}
+
 } // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "Precompiled.h"
+#include "CookedFormat.h"
+
+// records are copied straight in and out of the file, every Windows target is little-endian
+#if !defined(_MSC_VER) && !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#error "[Cooked] Cooked files are little-endian only."
+#endif
+
+namespace GameEngine
+{
+namespace Cooked
+{
+
+bool IsCookedFile(const char* fileName)
+{
+	const size_t length = std::strlen(fileName);
+	const size_t extensionLength = std::strlen(kExtension);
+	return length >= extensionLength && std::strcmp(fileName + length - extensionLength, kExtension) == 0;
+}
+
+std::string GetCookedFileName(const char* fileName)
+{
+	std::string cookedFileName(fileName);
+	const size_t dot = cookedFileName.find_last_of('.');
+	const size_t slash = cookedFileName.find_last_of("/\\");
+	if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+	{
+		cookedFileName.erase(dot);
+	}
+	return cookedFileName + kExtension;
+}
+
+Reader::Reader()
+	: mData(nullptr)
+	, mHeader(nullptr)
+	, mStrings(nullptr)
+{
+}
+
+bool Reader::Open(const uint8_t* data, size_t size, FileType fileType)
+{
+	if (data == nullptr || size < sizeof(Header))
+	{
+		return false;
+	}
+
+	const Header* header = reinterpret_cast<const Header*>(data);
+	if (header->magic != kMagic ||
+		header->version != kVersion ||
+		header->fileType != static_cast<uint16_t>(fileType))
+	{
+		LOG("[Cooked] Wrong file type or version %d (expected %d).", header->version, kVersion);
+		return false;
+	}
+
+	// string table must be in range and end in a terminator
+	const uint64_t stringEnd = static_cast<uint64_t>(header->stringTableOffset) + header->stringTableSize;
+	if (header->stringTableSize == 0 || stringEnd > size || data[stringEnd - 1] != '\0')
+	{
+		return false;
+	}
+	const uint8_t* records = data + header->recordOffset;
+	const uint8_t* recordsEnd = data + header->stringTableOffset;
+	if (header->recordOffset < sizeof(Header) || records > recordsEnd)
+	{
+		return false;
+	}
+
+	if (fileType == FileType::Level)
+	{
+		const uint64_t recordBytes = static_cast<uint64_t>(header->recordCount) * sizeof(ObjectRecord);
+		if (recordBytes > static_cast<uint64_t>(recordsEnd - records))
+		{
+			return false;
+		}
+		const ObjectRecord* objects = reinterpret_cast<const ObjectRecord*>(records);
+		for (uint32_t i = 0; i < header->recordCount; ++i)
+		{
+			if (objects[i].name >= header->stringTableSize || objects[i].templateName >= header->stringTableSize)
+			{
+				return false;
+			}
+		}
+	}
+	else
+	{
+		const uint8_t* cursor = records;
+		for (uint32_t i = 0; i < header->recordCount; ++i)
+		{
+			if (static_cast<size_t>(recordsEnd - cursor) < sizeof(ComponentRecord))
+			{
+				return false;
+			}
+			const ComponentRecord* record = reinterpret_cast<const ComponentRecord*>(cursor);
+			cursor += sizeof(ComponentRecord);
+			if (record->type >= header->stringTableSize || Align4(record->size) > static_cast<size_t>(recordsEnd - cursor))
+			{
+				return false;
+			}
+			cursor += Align4(record->size);
+		}
+	}
+
+	mData = data;
+	mHeader = header;
+	mStrings = reinterpret_cast<const char*>(data + header->stringTableOffset);
+	return true;
+}
+
+const ObjectRecord* Reader::GetObjects() const
+{
+	ASSERT(mHeader->fileType == static_cast<uint16_t>(FileType::Level), "[Cooked] Not a level file.");
+	return reinterpret_cast<const ObjectRecord*>(mData + mHeader->recordOffset);
+}
+
+Writer::Writer(FileType fileType)
+	: mFileType(fileType)
+	, mRecordCount(0)
+{
+}
+
+uint32_t Writer::AddString(const char* str)
+{
+	auto iter = mStringOffsets.find(str);
+	if (iter != mStringOffsets.end())
+	{
+		return iter->second;
+	}
+
+	const uint32_t offset = static_cast<uint32_t>(mStrings.size());
+	mStrings.insert(mStrings.end(), str, str + std::strlen(str) + 1);
+	mStringOffsets.emplace(str, offset);
+	return offset;
+}
+
+void Writer::AddComponent(const char* type, const void* data, uint32_t size)
+{
+	ASSERT(mFileType == FileType::Template, "[Cooked] Components only go into template files.");
+
+	ComponentRecord record;
+	record.type = AddString(type);
+	record.size = size;
+
+	const uint8_t* recordBytes = reinterpret_cast<const uint8_t*>(&record);
+	mRecords.insert(mRecords.end(), recordBytes, recordBytes + sizeof(record));
+	const uint8_t* payload = static_cast<const uint8_t*>(data);
+	mRecords.insert(mRecords.end(), payload, payload + size);
+	mRecords.resize(mRecords.size() + Align4(size) - size, 0);
+	++mRecordCount;
+}
+
+void Writer::AddObject(const ObjectRecord& object)
+{
+	ASSERT(mFileType == FileType::Level, "[Cooked] Objects only go into level files.");
+
+	const uint8_t* objectBytes = reinterpret_cast<const uint8_t*>(&object);
+	mRecords.insert(mRecords.end(), objectBytes, objectBytes + sizeof(object));
+	++mRecordCount;
+}
+
+bool Writer::Save(const char* fileName) const
+{
+	std::vector<char> strings(mStrings);
+	if (strings.empty())
+	{
+		strings.push_back('\0');
+	}
+
+	Header header;
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.fileType = static_cast<uint16_t>(mFileType);
+	header.recordCount = mRecordCount;
+	header.recordOffset = sizeof(Header);
+	header.stringTableOffset = header.recordOffset + static_cast<uint32_t>(mRecords.size());
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+
+	FILE* file = std::fopen(fileName, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	bool success = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	success = success && (mRecords.empty() || std::fwrite(mRecords.data(), mRecords.size(), 1, file) == 1);
+	success = success && std::fwrite(strings.data(), strings.size(), 1, file) == 1;
+	success = (std::fclose(file) == 0) && success;
+	return success;
+}
+
+} // namespace Cooked
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "Precompiled.h"
+#include "Cooker.h"
+
+#include "AABoxColliderComponent.h"
+#include "LevelFile.h"
+#include "TransformComponent.h"
+
+namespace GameEngine
+{
+
+Cooker::Cooker()
+{
+	Register<AABoxColliderComponent>("ColliderComponent");
+	Register<TransformComponent>("TransformComponent");
+	Register("CameraComponent");
+	Register("FPControllerComponent");
+}
+
+void Cooker::Register(std::string name)
+{
+	Register(std::move(name), [](const TiXmlNode*, std::vector<uint8_t>& payload)
+	{
+		payload.clear();
+	});
+}
+
+void Cooker::Register(std::string name, CookFunc func)
+{
+	mCookFuncs[std::move(name)] = std::move(func);
+}
+
+bool Cooker::Cook(const char* fileName, const char* cookedFileName)
+{
+	TiXmlDocument doc(fileName);
+	if (!doc.LoadFile())
+	{
+		LOG("[Cooker] Failed to open %s.", fileName);
+		return false;
+	}
+
+	const TiXmlElement* root = doc.FirstChildElement();
+	if (root == nullptr)
+	{
+		LOG("[Cooker] %s is empty.", fileName);
+		return false;
+	}
+
+	if (std::strcmp(root->Value(), "GameObject") == 0)
+	{
+		Cooked::Writer writer(Cooked::FileType::Template);
+		return CookTemplate(root, writer) && writer.Save(cookedFileName);
+	}
+	if (std::strcmp(root->Value(), "GameObjectList") == 0)
+	{
+		Cooked::Writer writer(Cooked::FileType::Level);
+		return CookLevel(root, writer) && writer.Save(cookedFileName);
+	}
+
+	LOG("[Cooker] %s has unknown root element %s.", fileName, root->Value());
+	return false;
+}
+
+bool Cooker::CookTemplate(const TiXmlElement* root, Cooked::Writer& writer)
+{
+	std::vector<uint8_t> payload;
+
+	const TiXmlElement* components = root->FirstChildElement("Components");
+	const TiXmlElement* element = components ? components->FirstChildElement() : nullptr;
+	while (element)
+	{
+		auto iter = mCookFuncs.find(element->Value());
+		if (iter == mCookFuncs.end())
+		{
+			// fail rather than silently drop data from the cooked file
+			LOG("[Cooker] No cook function registered for %s.", element->Value());
+			return false;
+		}
+
+		payload.clear();
+		iter->second(element, payload);
+		writer.AddComponent(element->Value(), payload.data(), static_cast<uint32_t>(payload.size()));
+
+		element = element->NextSiblingElement();
+	}
+	return true;
+}
+
+bool Cooker::CookLevel(const TiXmlElement* root, Cooked::Writer& writer)
+{
+	std::vector<LevelEntry> entries;
+	if (!ReadLevel(root, entries))
+	{
+		return false;
+	}
+
+	for (auto& entry : entries)
+	{
+		Cooked::ObjectRecord object = {};
+		object.name = writer.AddString(entry.name.c_str());
+		object.templateName = writer.AddString(Cooked::GetCookedFileName(entry.templateFileName.c_str()).c_str());
+		if (entry.bHasPosition)
+		{
+			object.flags |= Cooked::ObjectRecord::kHasPosition;
+			object.position[0] = entry.position.x;
+			object.position[1] = entry.position.y;
+			object.position[2] = entry.position.z;
+		}
+		writer.AddObject(object);
+	}
+	return true;
+}
+
+} // namespace GameEngine
\ No newline at end of file
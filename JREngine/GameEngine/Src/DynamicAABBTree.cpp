@@ -0,0 +1,351 @@
+#include "Precompiled.h"
+#include "DynamicAABBTree.h"
+
+namespace GameEngine
+{
+
+namespace
+{
+	// surface area of the box spanned by two corners, the insertion cost metric
+	inline float Area(const Math::Vector3& min, const Math::Vector3& max)
+	{
+		const float x = max.x - min.x;
+		const float y = max.y - min.y;
+		const float z = max.z - min.z;
+		return 2.0f * (x * y + y * z + z * x);
+	}
+
+	inline Math::Vector3 Min(const Math::Vector3& a, const Math::Vector3& b)
+	{
+		return Math::Vector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+	}
+
+	inline Math::Vector3 Max(const Math::Vector3& a, const Math::Vector3& b)
+	{
+		return Math::Vector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+	}
+}
+
+DynamicAABBTree::DynamicAABBTree(float margin)
+	: mRoot(kNullNode)
+	, mFreeList(kNullNode)
+	, mProxyCount(0)
+	, mMargin(margin)
+{
+}
+
+int32_t DynamicAABBTree::CreateProxy(const Math::AABB& aabb, void* userData)
+{
+	const int32_t proxy = AllocateNode();
+	Node& node = mNodes[proxy];
+	const Math::Vector3 margin(mMargin, mMargin, mMargin);
+	node.min = aabb.center - aabb.extend - margin;
+	node.max = aabb.center + aabb.extend + margin;
+	node.userData = userData;
+	node.height = 0;
+
+	InsertLeaf(proxy);
+	++mProxyCount;
+	return proxy;
+}
+
+void DynamicAABBTree::DestroyProxy(int32_t proxy)
+{
+	ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(mNodes.size()) && mNodes[proxy].IsLeaf(), "[DynamicAABBTree] Invalid proxy.");
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--mProxyCount;
+}
+
+bool DynamicAABBTree::MoveProxy(int32_t proxy, const Math::AABB& aabb)
+{
+	ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(mNodes.size()) && mNodes[proxy].IsLeaf(), "[DynamicAABBTree] Invalid proxy.");
+	Node& node = mNodes[proxy];
+	const Math::Vector3 min = aabb.center - aabb.extend;
+	const Math::Vector3 max = aabb.center + aabb.extend;
+	if (node.min.x <= min.x && node.min.y <= min.y && node.min.z <= min.z &&
+		node.max.x >= max.x && node.max.y >= max.y && node.max.z >= max.z)
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	const Math::Vector3 margin(mMargin, mMargin, mMargin);
+	node.min = min - margin;
+	node.max = max + margin;
+	InsertLeaf(proxy);
+	return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+	mNodes.clear();
+	mRoot = kNullNode;
+	mFreeList = kNullNode;
+	mProxyCount = 0;
+}
+
+Math::AABB DynamicAABBTree::GetFatAABB(int32_t proxy) const
+{
+	const Node& node = mNodes[proxy];
+	return Math::AABB((node.min + node.max) * 0.5f, (node.max - node.min) * 0.5f);
+}
+
+void DynamicAABBTree::Split(uint32_t count, std::vector<int32_t>& roots) const
+{
+	roots.clear();
+	if (mRoot == kNullNode)
+	{
+		return;
+	}
+
+	// replace the first inner node by its children until there are enough
+	roots.push_back(mRoot);
+	size_t next = 0;
+	while (roots.size() < count && next < roots.size())
+	{
+		const Node& node = mNodes[roots[next]];
+		if (node.IsLeaf())
+		{
+			++next;
+			continue;
+		}
+		roots[next] = node.child1;
+		roots.push_back(node.child2);
+	}
+}
+
+float DynamicAABBTree::DistanceSqr(const Math::Vector3& point, const Math::Vector3& min, const Math::Vector3& max)
+{
+	// zero inside the box
+	const float dx = std::max(std::max(min.x - point.x, point.x - max.x), 0.0f);
+	const float dy = std::max(std::max(min.y - point.y, point.y - max.y), 0.0f);
+	const float dz = std::max(std::max(min.z - point.z, point.z - max.z), 0.0f);
+	return dx * dx + dy * dy + dz * dz;
+}
+
+int32_t DynamicAABBTree::AllocateNode()
+{
+	if (mFreeList == kNullNode)
+	{
+		mNodes.emplace_back();
+		mFreeList = static_cast<int32_t>(mNodes.size()) - 1;
+		mNodes.back().parent = kNullNode;
+	}
+
+	const int32_t index = mFreeList;
+	Node& node = mNodes[index];
+	mFreeList = node.parent;
+	node.parent = kNullNode;
+	node.child1 = kNullNode;
+	node.child2 = kNullNode;
+	node.userData = nullptr;
+	node.height = 0;
+	return index;
+}
+
+void DynamicAABBTree::FreeNode(int32_t node)
+{
+	mNodes[node].parent = mFreeList;
+	mNodes[node].height = -1;
+	mFreeList = node;
+}
+
+void DynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+	if (mRoot == kNullNode)
+	{
+		mRoot = leaf;
+		mNodes[leaf].parent = kNullNode;
+		return;
+	}
+
+	// walk down to the sibling that grows the total area the least, the
+	// inheritance cost is what every ancestor pays for the larger box
+	const Math::Vector3 leafMin = mNodes[leaf].min;
+	const Math::Vector3 leafMax = mNodes[leaf].max;
+	int32_t index = mRoot;
+	while (!mNodes[index].IsLeaf())
+	{
+		const Node& node = mNodes[index];
+		const float area = Area(node.min, node.max);
+		const float combinedArea = Area(Min(node.min, leafMin), Max(node.max, leafMax));
+
+		const float cost = 2.0f * combinedArea;
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		float childCost[2];
+		const int32_t children[2] = { node.child1, node.child2 };
+		for (int i = 0; i < 2; ++i)
+		{
+			const Node& child = mNodes[children[i]];
+			const float newArea = Area(Min(child.min, leafMin), Max(child.max, leafMax));
+			childCost[i] = (child.IsLeaf() ? newArea : newArea - Area(child.min, child.max)) + inheritanceCost;
+		}
+
+		if (cost < childCost[0] && cost < childCost[1])
+		{
+			break;
+		}
+		index = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = mNodes[sibling].parent;
+	const int32_t newParent = AllocateNode();
+	mNodes[newParent].parent = oldParent;
+	mNodes[newParent].min = Min(mNodes[sibling].min, leafMin);
+	mNodes[newParent].max = Max(mNodes[sibling].max, leafMax);
+	mNodes[newParent].height = mNodes[sibling].height + 1;
+	mNodes[newParent].child1 = sibling;
+	mNodes[newParent].child2 = leaf;
+	mNodes[sibling].parent = newParent;
+	mNodes[leaf].parent = newParent;
+
+	if (oldParent == kNullNode)
+	{
+		mRoot = newParent;
+	}
+	else if (mNodes[oldParent].child1 == sibling)
+	{
+		mNodes[oldParent].child1 = newParent;
+	}
+	else
+	{
+		mNodes[oldParent].child2 = newParent;
+	}
+
+	Refit(mNodes[leaf].parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+	if (leaf == mRoot)
+	{
+		mRoot = kNullNode;
+		return;
+	}
+
+	// the sibling takes the parent's place
+	const int32_t parent = mNodes[leaf].parent;
+	const int32_t grandParent = mNodes[parent].parent;
+	const int32_t sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+	if (grandParent == kNullNode)
+	{
+		mRoot = sibling;
+		mNodes[sibling].parent = kNullNode;
+		FreeNode(parent);
+		return;
+	}
+
+	if (mNodes[grandParent].child1 == parent)
+	{
+		mNodes[grandParent].child1 = sibling;
+	}
+	else
+	{
+		mNodes[grandParent].child2 = sibling;
+	}
+	mNodes[sibling].parent = grandParent;
+	FreeNode(parent);
+
+	Refit(grandParent);
+}
+
+void DynamicAABBTree::Refit(int32_t node)
+{
+	// fix boxes and heights up to the root, balancing on the way
+	while (node != kNullNode)
+	{
+		node = Balance(node);
+
+		Node& current = mNodes[node];
+		const Node& child1 = mNodes[current.child1];
+		const Node& child2 = mNodes[current.child2];
+		current.height = 1 + std::max(child1.height, child2.height);
+		current.min = Min(child1.min, child2.min);
+		current.max = Max(child1.max, child2.max);
+
+		node = current.parent;
+	}
+}
+
+int32_t DynamicAABBTree::Balance(int32_t iA)
+{
+	// rotates the taller child up when A's children differ in height by
+	// more than one, returns the node now at A's position
+	const Node& A = mNodes[iA];
+	if (A.IsLeaf() || A.height < 2)
+	{
+		return iA;
+	}
+
+	const int32_t iB = A.child1;
+	const int32_t iC = A.child2;
+	const int32_t balance = mNodes[iC].height - mNodes[iB].height;
+	if (balance > 1)
+	{
+		return Rotate(iA, iC, iB);
+	}
+	if (balance < -1)
+	{
+		return Rotate(iA, iB, iC);
+	}
+	return iA;
+}
+
+int32_t DynamicAABBTree::Rotate(int32_t iA, int32_t iUp, int32_t iOther)
+{
+	Node& A = mNodes[iA];
+	Node& up = mNodes[iUp];
+	const Node& other = mNodes[iOther];
+	const int32_t iF = up.child1;
+	const int32_t iG = up.child2;
+	const bool bUpWasChild2 = A.child2 == iUp;
+
+	// up takes A's place, A becomes its first child
+	up.child1 = iA;
+	up.parent = A.parent;
+	A.parent = iUp;
+	if (up.parent == kNullNode)
+	{
+		mRoot = iUp;
+	}
+	else if (mNodes[up.parent].child1 == iA)
+	{
+		mNodes[up.parent].child1 = iUp;
+	}
+	else
+	{
+		mNodes[up.parent].child2 = iUp;
+	}
+
+	// the taller of up's old children stays with it, the other one fills
+	// the slot up left in A
+	const bool bKeepF = mNodes[iF].height > mNodes[iG].height;
+	const int32_t iKeep = bKeepF ? iF : iG;
+	const int32_t iMove = bKeepF ? iG : iF;
+	const Node& keep = mNodes[iKeep];
+	Node& move = mNodes[iMove];
+	up.child2 = iKeep;
+	if (bUpWasChild2)
+	{
+		A.child2 = iMove;
+	}
+	else
+	{
+		A.child1 = iMove;
+	}
+	move.parent = iA;
+
+	A.min = Min(other.min, move.min);
+	A.max = Max(other.max, move.max);
+	A.height = 1 + std::max(other.height, move.height);
+	up.min = Min(A.min, keep.min);
+	up.max = Max(A.max, keep.max);
+	up.height = 1 + std::max(A.height, keep.height);
+	return iUp;
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Precompiled.h"
+
+#if !defined(CORE_HEADLESS)
 #include "FPControllerComponent.h"
 
 #include "GameObject.h"
 #include "CameraComponent.h"
 
-#include <Input\Inc\Input.h>
+#include <Input/Inc/Input.h>
 
 namespace GameEngine
 {
@@ -15,6 +17,20 @@ void FPControllerComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* nod
 	auto elem = node->FirstChildElement();
 }
 
+void FPControllerComponent::CloneFunc(GameObject* gameObj, const Component* source)
+{
+	auto newComponent = gameObj->AddComponent<FPControllerComponent>();
+	auto sourceComponent = static_cast<const FPControllerComponent*>(source);
+	newComponent->mBaseSpeed = sourceComponent->mBaseSpeed;
+	newComponent->mSpeedMultiplier = sourceComponent->mSpeedMultiplier;
+	newComponent->mTurnSpeed = sourceComponent->mTurnSpeed;
+}
+
+void FPControllerComponent::LoadFunc(GameObject* gameObj, const void* data, uint32_t size)
+{
+	gameObj->AddComponent<FPControllerComponent>();
+}
+
 FPControllerComponent::FPControllerComponent()
 	: mBaseSpeed{ 5.0f }
 	, mSpeedMultiplier{ 2.5f }
@@ -68,4 +84,6 @@ void FPControllerComponent::Update(float dTime)
 	}
 }
 
-} // namespace GameEngine
\ No newline at end of file
+} // namespace GameEngine
+
+#endif // #if !defined(CORE_HEADLESS)
\ No newline at end of file
@@ -2,15 +2,23 @@
 #include "GameObject.h"
 
 #include "Component.h"
+#include "World.h"
 
-#include <Core\Inc\TypedAllocator.h>
-#include <Core\Inc\HandlePool.h>
+#include <Core/Inc/TypedAllocator.h>
+#include <Core/Inc/HandlePool.h>
 
 namespace GameEngine
 {
 
 GameObject::GameObject()
+	: mComponentMask(0)
+	, mWorld(nullptr)
+	, mUpdateIndex(0)
+	, mNameIndex(0)
+	, mVisibilityIndex(0)
+	, mTemplateId(kNoTemplate)
 {
+	std::memset(mComponentSlots, kNoComponent, sizeof(mComponentSlots));
 }
 
 GameObject::~GameObject()
@@ -30,31 +38,111 @@ void GameObject::Terminate()
 	for (auto& component : mComponents)
 	{
 		component->Terminate();
+		if (component->IsTickByDistance())
+		{
+			mWorld->GetTickScheduler().RemoveByDistance(component.get());
+		}
 	}
 	mComponents.clear();
+	mComponentMask = 0;
+	std::memset(mComponentSlots, kNoComponent, sizeof(mComponentSlots));
 }
 
 void GameObject::Update(float dTime)
 {
+	// components of scheduled pools are updated by their pool's pass in World::Update
+	const uint32_t frame = mWorld ? mWorld->GetTickScheduler().GetFrame() : 0;
+	float tickTime;
 	for (auto& component : mComponents)
 	{
-		component->Update(dTime);
+		const ComponentPoolBase* pool = component.get_deleter().pool;
+		if ((pool == nullptr || !pool->IsScheduled()) && component->ConsumeTick(frame, dTime, tickTime))
+		{
+			if (pool)
+			{
+				Component* componentPtr = component.get();
+				mWorld->GetProfiler().TimeComponent(ProfileStage::Update, pool->GetTypeIndex(), [componentPtr, tickTime]()
+				{
+					componentPtr->Update(tickTime);
+				});
+			}
+			else
+			{
+				component->Update(tickTime);
+			}
+		}
 	}
 }
 
-void GameObject::Render()
+void GameObject::Sleep()
 {
 	for (auto& component : mComponents)
 	{
-		component->Render();
+		component->Sleep();
 	}
 }
 
+void GameObject::Wake()
+{
+	for (auto& component : mComponents)
+	{
+		component->Wake();
+	}
+}
+
+void GameObject::Extract(RenderList& list)
+{
+	RenderComponents(ProfileStage::Render, &list);
+}
+
 void GameObject::Render2D()
+{
+	RenderComponents(ProfileStage::Render2D, nullptr);
+}
+
+void GameObject::RenderComponents(ProfileStage stage, RenderList* list)
+{
+	for (auto& component : mComponents)
+	{
+		Component* componentPtr = component.get();
+		const ComponentPoolBase* pool = component.get_deleter().pool;
+		const auto render = [componentPtr, list]()
+		{
+			if (list)
+			{
+				componentPtr->Extract(*list);
+			}
+			else
+			{
+				componentPtr->Render2D();
+			}
+		};
+
+		if (pool)
+		{
+			mWorld->GetProfiler().TimeComponent(stage, pool->GetTypeIndex(), render);
+		}
+		else
+		{
+			render();
+		}
+	}
+}
+
+ComponentPoolBase* GameObject::GetComponentPool(uint32_t typeIndex, ComponentPoolFactory factory) const
+{
+	return mWorld ? mWorld->GetOrAddComponentPool(typeIndex, factory) : nullptr;
+}
+
+void GameObject::SetComponentsActive(bool active)
 {
 	for (auto& component : mComponents)
 	{
-		component->Render2D();
+		const ComponentDeleter& deleter = component.get_deleter();
+		if (deleter.pool)
+		{
+			deleter.pool->SetActive(deleter.slot, active);
+		}
 	}
 }
 
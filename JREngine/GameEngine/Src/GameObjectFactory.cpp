@@ -2,66 +2,300 @@
 #include "GameObjectFactory.h"
 
 #include "AABoxColliderComponent.h"
-#include "CameraComponent.h"
+#include "CookedFormat.h"
 #include "TransformComponent.h"
 
 namespace GameEngine
 {
 
-GameObjectFactory::GameObjectFactory(GameObjectAllocator& allocator)
+GameObjectFactory::GameObjectFactory(GameObjectAllocator& allocator, World& world)
 	: mGameObjectAllocator(allocator)
+	, mWorld(world)
 {
 }
 
-bool GameObjectFactory::Register(std::string name, CreateFunc func)
+GameObjectFactory::~GameObjectFactory()
 {
-	auto result = mCreateFuncMap.emplace(std::move(name), func);
+}
+
+bool GameObjectFactory::Register(std::string name, CreateFunc func, CloneFunc cloneFunc, LoadFunc loadFunc)
+{
+	auto result = mCreateFuncMap.emplace(std::move(name), Funcs{ func, cloneFunc, loadFunc });
 	return result.second;
 }
 
 GameObject* GameObjectFactory::Create(const char* templateFileName)
 {
-	GameObject* gameObject = mGameObjectAllocator.New();
+	const Template* objectTemplate = FindTemplate(templateFileName);
+	if (objectTemplate == nullptr)
+	{
+		return nullptr;
+	}
 
+	GameObject* gameObject = mGameObjectAllocator.New();
 	if (gameObject == nullptr)
 	{
 		return nullptr;
 	}
+	// components look up their pools through the world while being added
+	gameObject->mWorld = &mWorld;
+
+	for (auto& instruction : objectTemplate->instructions)
+	{
+		if (instruction.source)
+		{
+			instruction.funcs->clone(gameObject, instruction.source);
+		}
+		else
+		{
+			instruction.funcs->create(gameObject, instruction.element);
+		}
+	}
+
+	return gameObject;
+}
+
+uint32_t GameObjectFactory::CreateBatch(const char* templateFileName, uint32_t count, std::vector<GameObject*>& gameObjects)
+{
+	const Template* objectTemplate = FindTemplate(templateFileName);
+	if (objectTemplate == nullptr || count == 0)
+	{
+		return 0;
+	}
+
+	const size_t first = gameObjects.size();
+	gameObjects.reserve(first + count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		GameObject* gameObject = mGameObjectAllocator.New();
+		if (gameObject == nullptr)
+		{
+			break;
+		}
+		gameObject->mWorld = &mWorld;
+		gameObjects.push_back(gameObject);
+	}
+
+	const size_t last = gameObjects.size();
+	for (auto& instruction : objectTemplate->instructions)
+	{
+		for (size_t i = first; i < last; ++i)
+		{
+			const uint32_t componentCount = gameObjects[i]->mComponents.size();
+			if (instruction.source)
+			{
+				instruction.funcs->clone(gameObjects[i], instruction.source);
+			}
+			else
+			{
+				instruction.funcs->create(gameObjects[i], instruction.element);
+			}
+
+			// the first object tells which pool the entry uses, make room for the rest at once;
+			// entries adding no or several components are left to grow their pools
+			if (i == first && gameObjects[i]->mComponents.size() == componentCount + 1)
+			{
+				if (ComponentPoolBase* pool = gameObjects[i]->mComponents.back().get_deleter().pool)
+				{
+					pool->Reserve(pool->GetCount() + static_cast<uint32_t>(last - first));
+				}
+			}
+		}
+	}
+
+	return static_cast<uint32_t>(last - first);
+}
+
+void GameObjectFactory::Destroy(GameObject* gameObject)
+{
+	mGameObjectAllocator.Delete(gameObject);
+}
+
+bool GameObjectFactory::Preload(const char* templateFileName)
+{
+	return FindTemplate(templateFileName) != nullptr;
+}
+
+void GameObjectFactory::Invalidate(const char* templateFileName)
+{
+	auto iter = mTemplates.find(Core::HashString(templateFileName));
+	if (iter == mTemplates.end())
+	{
+		return;
+	}
+
+	auto& bucket = iter->second;
+	for (auto templateIter = bucket.begin(); templateIter != bucket.end(); ++templateIter)
+	{
+		if ((*templateIter)->fileName == templateFileName)
+		{
+			bucket.erase(templateIter);
+			break;
+		}
+	}
+	if (bucket.empty())
+	{
+		mTemplates.erase(iter);
+	}
+}
+
+void GameObjectFactory::InvalidateAll()
+{
+	mTemplates.clear();
+}
+
+void GameObjectFactory::AddTemplate(std::unique_ptr<Template> objectTemplate)
+{
+	auto& bucket = mTemplates[Core::HashString(objectTemplate->fileName.c_str())];
+	for (auto& cachedTemplate : bucket)
+	{
+		if (cachedTemplate->fileName == objectTemplate->fileName)
+		{
+			// a Create on the main thread got there first
+			return;
+		}
+	}
+	bucket.push_back(std::move(objectTemplate));
+}
+
+const GameObjectFactory::Template* GameObjectFactory::FindTemplate(const char* templateFileName)
+{
+	const uint32_t hash = Core::HashString(templateFileName);
+	auto& bucket = mTemplates[hash];
+	for (auto& objectTemplate : bucket)
+	{
+		if (objectTemplate->fileName == templateFileName)
+		{
+			return objectTemplate.get();
+		}
+	}
+
+	// first use, parse the file once
+	std::unique_ptr<Template> objectTemplate = PrepareTemplate(templateFileName);
+	if (objectTemplate == nullptr)
+	{
+		if (bucket.empty())
+		{
+			mTemplates.erase(hash);
+		}
+		return nullptr;
+	}
+	bucket.push_back(std::move(objectTemplate));
+	return bucket.back().get();
+}
+
+std::unique_ptr<GameObjectFactory::Template> GameObjectFactory::PrepareTemplate(const char* templateFileName) const
+{
+	if (Cooked::IsCookedFile(templateFileName))
+	{
+		return LoadCookedTemplate(templateFileName);
+	}
+
+	auto objectTemplate = std::make_unique<Template>();
+	objectTemplate->fileName = templateFileName;
+	objectTemplate->document = std::make_unique<TiXmlDocument>(templateFileName);
+	objectTemplate->prototype = std::make_unique<GameObject>();
 
-	TiXmlDocument doc(templateFileName);
-	if (!doc.LoadFile())
+	if (!objectTemplate->document->LoadFile())
 	{
+		LOG("[GameObjectFactory] Failed to load template %s.", templateFileName);
 		return nullptr;
 	}
 
-	TiXmlHandle handleDoc(&doc);
-	TiXmlElement* element;
-	TiXmlHandle handleRoot(0);
+	TiXmlHandle handleDoc(objectTemplate->document.get());
 
 	// root
-	element = handleDoc.FirstChildElement().Element();
+	TiXmlElement* element = handleDoc.FirstChildElement().Element();
 	if (!element)
 	{
 		return nullptr;
 	}
-	handleRoot = TiXmlHandle(element);
+	TiXmlHandle handleRoot(element);
 
 	// check all components
+	bool bNeedsDocument = false;
+	GameObject& prototype = *objectTemplate->prototype;
 	element = handleRoot.FirstChild("Components").FirstChild().Element();
-	while(element)
+	while (element)
 	{
-		const char *ComponentType = element->Value();
+		const char* componentType = element->Value();
 
-		mCreateFuncMap[std::string(ComponentType)](gameObject, element);
+		// component types without a create function (e.g. render-only components
+		// in a headless build) are skipped
+		auto iter = mCreateFuncMap.find(componentType);
+		if (iter == mCreateFuncMap.end())
+		{
+			LOG("[GameObjectFactory] No create function registered for %s.", componentType);
+		}
+		else if (iter->second.clone)
+		{
+			// decode the parameters once into the prototype
+			const uint32_t componentCount = prototype.mComponents.size();
+			iter->second.create(&prototype, element);
+			if (prototype.mComponents.size() == componentCount + 1)
+			{
+				objectTemplate->instructions.push_back({ &iter->second, prototype.mComponents.back().get(), nullptr });
+			}
+			else
+			{
+				// no single component to clone from, rebuild it from the XML instead
+				LOG("[GameObjectFactory] Cloneable create function for %s must add exactly one component.", componentType);
+				objectTemplate->instructions.push_back({ &iter->second, nullptr, element });
+				bNeedsDocument = true;
+			}
+		}
+		else
+		{
+			objectTemplate->instructions.push_back({ &iter->second, nullptr, element });
+			bNeedsDocument = true;
+		}
 		element = element->NextSiblingElement();
 	}
 
-	return gameObject;
+	if (!bNeedsDocument)
+	{
+		objectTemplate->document.reset();
+	}
+	return objectTemplate;
 }
 
-void GameObjectFactory::Destroy(GameObject* gameObject)
+std::unique_ptr<GameObjectFactory::Template> GameObjectFactory::LoadCookedTemplate(const char* templateFileName) const
 {
-	mGameObjectAllocator.Delete(gameObject);
+	Core::MappedFile file;
+	Cooked::Reader reader;
+	if (!file.Open(templateFileName) || !reader.Open(file.GetData(), file.GetSize(), Cooked::FileType::Template))
+	{
+		LOG("[GameObjectFactory] Failed to load cooked template %s.", templateFileName);
+		return nullptr;
+	}
+
+	auto objectTemplate = std::make_unique<Template>();
+	objectTemplate->fileName = templateFileName;
+	objectTemplate->prototype = std::make_unique<GameObject>();
+
+	// the file is only needed while the prototype is built
+	GameObject& prototype = *objectTemplate->prototype;
+	reader.ForEachComponent([&](const char* componentType, const void* data, uint32_t size)
+	{
+		auto iter = mCreateFuncMap.find(componentType);
+		if (iter == mCreateFuncMap.end() || !iter->second.load || !iter->second.clone)
+		{
+			LOG("[GameObjectFactory] No load and clone functions registered for %s.", componentType);
+			return;
+		}
+
+		const uint32_t componentCount = prototype.mComponents.size();
+		iter->second.load(&prototype, data, size);
+		if (prototype.mComponents.size() != componentCount + 1)
+		{
+			// there is no XML to fall back on, so the record is dropped
+			LOG("[GameObjectFactory] Load function for %s must add exactly one component.", componentType);
+			return;
+		}
+		objectTemplate->instructions.push_back({ &iter->second, prototype.mComponents.back().get(), nullptr });
+	});
+
+	return objectTemplate;
 }
 
 } // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Precompiled.h"
+#include "LevelFile.h"
+
+#include "CookedFormat.h"
+
+namespace GameEngine
+{
+
+namespace
+{
+	bool ReadCookedLevel(const char* levelFileName, std::vector<LevelEntry>& entries)
+	{
+		Core::MappedFile file;
+		Cooked::Reader reader;
+		if (!file.Open(levelFileName) || !reader.Open(file.GetData(), file.GetSize(), Cooked::FileType::Level))
+		{
+			return false;
+		}
+
+		const Cooked::ObjectRecord* objects = reader.GetObjects();
+		entries.reserve(entries.size() + reader.GetRecordCount());
+		for (uint32_t i = 0; i < reader.GetRecordCount(); ++i)
+		{
+			const Cooked::ObjectRecord& object = objects[i];
+			LevelEntry entry;
+			entry.name = reader.GetString(object.name);
+			entry.templateFileName = reader.GetString(object.templateName);
+			entry.bHasPosition = (object.flags & Cooked::ObjectRecord::kHasPosition) != 0;
+			entry.position = { object.position[0], object.position[1], object.position[2] };
+			entries.push_back(std::move(entry));
+		}
+		return true;
+	}
+}
+
+bool ReadLevel(const char* levelFileName, std::vector<LevelEntry>& entries)
+{
+	if (Cooked::IsCookedFile(levelFileName))
+	{
+		return ReadCookedLevel(levelFileName, entries);
+	}
+
+	TiXmlDocument doc(levelFileName);
+	if (!doc.LoadFile())
+	{
+		return false;
+	}
+
+	// root
+	const TiXmlElement* root = doc.FirstChildElement();
+	return root && ReadLevel(root, entries);
+}
+
+bool ReadLevel(const TiXmlElement* root, std::vector<LevelEntry>& entries)
+{
+	const TiXmlElement* element = root->FirstChildElement("GameObject");
+	while (element)
+	{
+		const TiXmlElement* name = element->FirstChildElement("Name");
+		const TiXmlElement* templateName = element->FirstChildElement("Template");
+		if (name == nullptr || name->GetText() == nullptr || templateName == nullptr || templateName->GetText() == nullptr)
+		{
+			LOG("[Level] GameObject entry is missing its Name or Template.");
+			return false;
+		}
+
+		LevelEntry entry;
+		entry.name = name->GetText();
+		entry.templateFileName = templateName->GetText();
+
+		// overrides
+		const TiXmlElement* vec = templateName->NextSiblingElement();
+		while (vec)
+		{
+			const char* overrideName = vec->Attribute("name");
+			if (overrideName && std::strcmp(overrideName, "Position") == 0)
+			{
+				float xyz[3] = {};
+				const TiXmlElement* dim = vec->FirstChildElement();
+				for (uint32_t i = 0; i < 3 && dim; ++i, dim = dim->NextSiblingElement())
+				{
+					xyz[i] = static_cast<float>(std::atof(dim->GetText()));
+				}
+				entry.position = { xyz[0], xyz[1], xyz[2] };
+				entry.bHasPosition = true;
+			}
+			vec = vec->NextSiblingElement();
+		}
+
+		entries.push_back(std::move(entry));
+		element = element->NextSiblingElement("GameObject");
+	}
+	return true;
+}
+
+} // namespace GameEngine
\ No newline at end of file
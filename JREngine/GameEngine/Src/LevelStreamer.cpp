@@ -0,0 +1,285 @@
+#include "Precompiled.h"
+#include "LevelStreamer.h"
+
+#include "World.h"
+
+namespace GameEngine
+{
+
+float LevelStreamer::Progress::GetFraction() const
+{
+	if (totalCount == 0)
+	{
+		return state == State::Loaded ? 1.0f : 0.0f;
+	}
+	// skipped objects count as done on the way up, there is nothing of them to unload
+	const uint32_t doneCount = state == State::Unloading ? activeCount : activeCount + failedCount;
+	return static_cast<float>(doneCount) / static_cast<float>(totalCount);
+}
+
+LevelStreamer::LevelStreamer(World& world)
+	: mWorld(world)
+	, mNextId(kInvalidLevel + 1)
+	, mFrameBudget(2.0f)
+{
+}
+
+LevelStreamer::~LevelStreamer()
+{
+	Terminate();
+}
+
+LevelStreamer::LevelId LevelStreamer::Load(const char* levelFileName)
+{
+	auto level = std::make_unique<Level>();
+	level->id = mNextId++;
+	level->fileName = levelFileName;
+
+	Level& newLevel = *level;
+	const GameObjectFactory& factory = *mWorld.mGameObjectFactory;
+	level->thread = std::thread([&newLevel, &factory]()
+	{
+		Read(newLevel, factory);
+	});
+
+	mLevels.push_back(std::move(level));
+	return newLevel.id;
+}
+
+void LevelStreamer::Cancel(LevelId levelId)
+{
+	Level* level = FindLevel(levelId);
+	if (level == nullptr)
+	{
+		return;
+	}
+
+	if (level->state == State::Reading)
+	{
+		// the loading thread stops early, Update drops the level once it has
+		level->bCancel.store(true);
+	}
+	else if (level->state == State::Activating)
+	{
+		level->state = State::Unloading;
+	}
+}
+
+void LevelStreamer::Unload(LevelId levelId)
+{
+	Level* level = FindLevel(levelId);
+	if (level == nullptr)
+	{
+		return;
+	}
+
+	switch (level->state)
+	{
+	case State::Reading:
+		level->bCancel.store(true);
+		break;
+	case State::Activating:
+	case State::Loaded:
+		level->state = State::Unloading;
+		break;
+	case State::Failed:
+		level->state = State::None;
+		break;
+	default:
+		break;
+	}
+}
+
+LevelStreamer::Progress LevelStreamer::GetProgress(LevelId levelId) const
+{
+	Progress progress;
+	if (const Level* level = FindLevel(levelId))
+	{
+		progress.state = level->state;
+		progress.activeCount = static_cast<uint32_t>(level->objects.size());
+		progress.totalCount = level->totalCount;
+		progress.failedCount = level->failedCount;
+	}
+	return progress;
+}
+
+bool LevelStreamer::IsBusy() const
+{
+	for (auto& level : mLevels)
+	{
+		if (level->state == State::Reading || level->state == State::Activating || level->state == State::Unloading)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void LevelStreamer::Update()
+{
+	const auto budget = std::chrono::duration<float, std::milli>(mFrameBudget);
+	const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(budget);
+	bool bWorked = false;
+
+	for (size_t i = 0; i < mLevels.size();)
+	{
+		Level& level = *mLevels[i];
+		if (level.state == State::Reading && level.bReadDone.load(std::memory_order_acquire))
+		{
+			FinishRead(level);
+		}
+
+		// always make some progress, even with a tiny budget
+		const bool bHasTime = !bWorked || Clock::now() < deadline;
+		if (bHasTime && level.state == State::Activating)
+		{
+			Activate(level, deadline);
+			bWorked = true;
+		}
+		else if (bHasTime && level.state == State::Unloading)
+		{
+			Deactivate(level, deadline);
+			bWorked = true;
+		}
+
+		if (level.state == State::None)
+		{
+			mLevels.erase(mLevels.begin() + i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void LevelStreamer::Terminate()
+{
+	for (auto& level : mLevels)
+	{
+		level->bCancel.store(true);
+		if (level->thread.joinable())
+		{
+			level->thread.join();
+		}
+	}
+	mLevels.clear();
+}
+
+void LevelStreamer::Read(Level& level, const GameObjectFactory& factory)
+{
+	level.bReadFailed = !ReadLevel(level.fileName.c_str(), level.entries);
+
+	// prepare every template once so the main thread only clones
+	std::unordered_set<std::string> templateNames;
+	for (auto& entry : level.entries)
+	{
+		if (level.bCancel.load(std::memory_order_relaxed))
+		{
+			break;
+		}
+		if (templateNames.insert(entry.templateFileName).second)
+		{
+			TemplatePtr objectTemplate = factory.PrepareTemplate(entry.templateFileName.c_str());
+			if (objectTemplate)
+			{
+				level.templates.push_back(std::move(objectTemplate));
+			}
+			else
+			{
+				level.failedTemplates.insert(entry.templateFileName);
+			}
+		}
+	}
+
+	level.bReadDone.store(true, std::memory_order_release);
+}
+
+LevelStreamer::Level* LevelStreamer::FindLevel(LevelId levelId)
+{
+	return const_cast<Level*>(static_cast<const LevelStreamer*>(this)->FindLevel(levelId));
+}
+
+const LevelStreamer::Level* LevelStreamer::FindLevel(LevelId levelId) const
+{
+	for (auto& level : mLevels)
+	{
+		if (level->id == levelId)
+		{
+			return level.get();
+		}
+	}
+	return nullptr;
+}
+
+void LevelStreamer::FinishRead(Level& level)
+{
+	level.thread.join();
+
+	if (level.bCancel.load())
+	{
+		level.state = State::None;
+		return;
+	}
+	if (level.bReadFailed)
+	{
+		LOG("[LevelStreamer] Failed to read level %s.", level.fileName.c_str());
+		level.state = State::Failed;
+		return;
+	}
+
+	for (auto& objectTemplate : level.templates)
+	{
+		mWorld.mGameObjectFactory->AddTemplate(std::move(objectTemplate));
+	}
+	level.templates.clear();
+
+	level.totalCount = static_cast<uint32_t>(level.entries.size());
+	level.objects.reserve(level.entries.size());
+	level.state = State::Activating;
+}
+
+void LevelStreamer::Activate(Level& level, Clock::time_point deadline)
+{
+	do
+	{
+		if (level.nextEntry == level.entries.size())
+		{
+			level.entries.clear();
+			level.entries.shrink_to_fit();
+			level.failedTemplates.clear();
+			level.state = State::Loaded;
+			return;
+		}
+		const LevelEntry& entry = level.entries[level.nextEntry++];
+		if (level.failedTemplates.count(entry.templateFileName) != 0)
+		{
+			// the factory would only try to read the file again, on this thread
+			LOG("[LevelStreamer] Skipped %s, template %s failed to load.", entry.name.c_str(), entry.templateFileName.c_str());
+			++level.failedCount;
+			continue;
+		}
+		level.objects.push_back(mWorld.Spawn(entry));
+	} while (Clock::now() < deadline);
+}
+
+void LevelStreamer::Deactivate(Level& level, Clock::time_point deadline)
+{
+	do
+	{
+		if (level.objects.empty())
+		{
+			level.state = State::None;
+			return;
+		}
+		// objects may have been destroyed by gameplay already
+		GameObjectHandle handle = level.objects.back();
+		level.objects.pop_back();
+		if (handle.IsValid())
+		{
+			mWorld.Destroy(handle);
+		}
+	} while (Clock::now() < deadline);
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "Precompiled.h"
+#include "MessageBus.h"
+
+namespace GameEngine
+{
+
+MessageBus::Stats MessageBus::ChannelBase::GetStats() const
+{
+	Stats stats = mStats;
+	stats.published = mPublished.load(std::memory_order_relaxed);
+	stats.overflowed = mOverflowed.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void MessageBus::ChannelBase::ResetStats()
+{
+	mStats.delivered = 0;
+	mStats.peak = 0;
+	mPublished.store(0, std::memory_order_relaxed);
+	mOverflowed.store(0, std::memory_order_relaxed);
+}
+
+MessageBus::MessageBus()
+	: mDropped(0)
+	, mNextSubscription(1)
+	, bDispatching(false)
+{
+}
+
+MessageBus::~MessageBus()
+{
+}
+
+void MessageBus::Unsubscribe(uint32_t subscription)
+{
+	for (auto& channel : mChannels)
+	{
+		if (channel && channel->Unsubscribe(subscription))
+		{
+			return;
+		}
+	}
+	ASSERT(false, "[MessageBus] Unknown subscription.");
+}
+
+void MessageBus::Dispatch()
+{
+	ASSERT(!bDispatching, "[MessageBus] Dispatch called from a message handler.");
+	bDispatching = true;
+
+	// a handler may publish to a channel that was already visited this round
+	bool bDelivered = true;
+	for (uint32_t round = 0; bDelivered && round < kMaxDispatchRounds; ++round)
+	{
+		bDelivered = false;
+		// handlers may register new types, so no iterators
+		for (size_t i = 0; i < mChannels.size(); ++i)
+		{
+			if (mChannels[i] && mChannels[i]->Deliver())
+			{
+				bDelivered = true;
+			}
+		}
+	}
+	bDispatching = false;
+}
+
+void MessageBus::Clear()
+{
+	ASSERT(!bDispatching, "[MessageBus] Cannot clear while dispatching.");
+	mChannels.clear();
+	mDropped.store(0, std::memory_order_relaxed);
+}
+
+void MessageBus::GetStats(std::vector<Stats>& stats) const
+{
+	stats.clear();
+	for (auto& channel : mChannels)
+	{
+		if (channel)
+		{
+			stats.push_back(channel->GetStats());
+		}
+	}
+}
+
+void MessageBus::LogStats() const
+{
+	std::vector<Stats> stats;
+	GetStats(stats);
+
+	LOGPRINTF("[MessageBus] %u channels, %llu messages dropped without a channel\n", static_cast<uint32_t>(stats.size()), static_cast<unsigned long long>(GetDroppedCount()));
+	LOGPRINTF("  %-4s %12s %12s %12s %9s %9s\n", "Type", "Published", "Delivered", "Overflowed", "Capacity", "Peak");
+	for (auto& entry : stats)
+	{
+		char name[5];
+		LOGPRINTF("  %-4s %12llu %12llu %12llu %9u %9u\n", Core::TypeIdToString(entry.type, name),
+			static_cast<unsigned long long>(entry.published),
+			static_cast<unsigned long long>(entry.delivered),
+			static_cast<unsigned long long>(entry.overflowed),
+			entry.capacity,
+			entry.peak);
+	}
+}
+
+void MessageBus::ResetStats()
+{
+	for (auto& channel : mChannels)
+	{
+		if (channel)
+		{
+			channel->ResetStats();
+		}
+	}
+	mDropped.store(0, std::memory_order_relaxed);
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Precompiled.h"
+#include "PairCache.h"
+
+namespace GameEngine
+{
+
+PairCache::PairCache(uint32_t capacity)
+	: mSlots(Core::NextPowerOfTwo(capacity < 16 ? 16 : capacity))
+	, mMask(static_cast<uint32_t>(mSlots.size()) - 1)
+	, mCount(0)
+{
+}
+
+bool PairCache::Touch(GameObjectHandle a, GameObjectHandle b, uint32_t frame)
+{
+	const uint64_t key = MakeKey(a, b);
+	uint32_t index = Hash(key) & mMask;
+	while (mSlots[index].key != 0)
+	{
+		if (mSlots[index].key == key)
+		{
+			mSlots[index].frame = frame;
+			return false;
+		}
+		index = (index + 1) & mMask;
+	}
+
+	Pair& pair = mSlots[index];
+	pair.key = key;
+	pair.objectA = a;
+	pair.objectB = b;
+	pair.frame = frame;
+
+	// keep the load factor at or below one half
+	if (++mCount * 2 > mSlots.size())
+	{
+		Grow();
+	}
+	return true;
+}
+
+void PairCache::Clear()
+{
+	for (auto& pair : mSlots)
+	{
+		pair = Pair();
+	}
+	mCount = 0;
+}
+
+uint64_t PairCache::MakeKey(GameObjectHandle a, GameObjectHandle b)
+{
+	const uint64_t idA = a.GetId();
+	const uint64_t idB = b.GetId();
+	return idA < idB ? (idA << 32) | idB : (idB << 32) | idA;
+}
+
+uint32_t PairCache::Hash(uint64_t key)
+{
+	// 64 bit finalizer from MurmurHash3
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ull;
+	key ^= key >> 33;
+	return static_cast<uint32_t>(key);
+}
+
+void PairCache::Grow()
+{
+	std::vector<Pair> oldSlots(mSlots.size() * 2);
+	oldSlots.swap(mSlots);
+	mMask = static_cast<uint32_t>(mSlots.size()) - 1;
+
+	for (auto& pair : oldSlots)
+	{
+		if (pair.key != 0)
+		{
+			uint32_t index = Hash(pair.key) & mMask;
+			while (mSlots[index].key != 0)
+			{
+				index = (index + 1) & mMask;
+			}
+			mSlots[index] = pair;
+		}
+	}
+}
+
+void PairCache::RemoveAt(uint32_t index)
+{
+	// backward shift deletion, pull later entries of the probe run into the
+	// hole unless that would move them in front of their home slot
+	uint32_t hole = index;
+	uint32_t next = (hole + 1) & mMask;
+	while (mSlots[next].key != 0)
+	{
+		const uint32_t home = Hash(mSlots[next].key) & mMask;
+		const bool bCanMove = ((next - home) & mMask) >= ((next - hole) & mMask);
+		if (bCanMove)
+		{
+			mSlots[hole] = mSlots[next];
+			hole = next;
+		}
+		next = (next + 1) & mMask;
+	}
+	mSlots[hole] = Pair();
+	--mCount;
+}
+
+} // namespace GameEngine
\ No newline at end of file
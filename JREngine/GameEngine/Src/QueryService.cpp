@@ -0,0 +1,228 @@
+#include "Precompiled.h"
+#include "QueryService.h"
+
+#include "AABoxColliderComponent.h"
+#include "TransformComponent.h"
+#include "World.h"
+
+namespace GameEngine
+{
+
+namespace
+{
+	// entry distance of the ray into the box clipped to [0, maxDistance],
+	// false if it misses
+	bool RayBox(const Math::Ray& ray, const Math::Vector3& invDir, const Math::AABB& aabb, float maxDistance, float& distance)
+	{
+		const Math::Vector3 min = aabb.center - aabb.extend;
+		const Math::Vector3 max = aabb.center + aabb.extend;
+		const float tx1 = (min.x - ray.origin.x) * invDir.x;
+		const float tx2 = (max.x - ray.origin.x) * invDir.x;
+		const float ty1 = (min.y - ray.origin.y) * invDir.y;
+		const float ty2 = (max.y - ray.origin.y) * invDir.y;
+		const float tz1 = (min.z - ray.origin.z) * invDir.z;
+		const float tz2 = (max.z - ray.origin.z) * invDir.z;
+		const float tEnter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+		const float tExit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+		distance = tEnter;
+		return tEnter <= tExit;
+	}
+
+	float DistanceSqr(const Math::Vector3& point, const Math::AABB& aabb)
+	{
+		const Math::Vector3 offset = point - aabb.center;
+		const float dx = std::max(Math::Abs(offset.x) - aabb.extend.x, 0.0f);
+		const float dy = std::max(Math::Abs(offset.y) - aabb.extend.y, 0.0f);
+		const float dz = std::max(Math::Abs(offset.z) - aabb.extend.z, 0.0f);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	Math::Ray Normalized(const Math::Ray& ray)
+	{
+		Math::Ray result = ray;
+		result.direction = Math::Normalize(ray.direction);
+		return result;
+	}
+}
+
+QueryService::QueryService()
+{
+	// refreshes the tree once colliders moved, after the broadphase used them
+	mUpdateDesc = UpdateDesc(UpdatePhase::Physics).Reads<AABoxColliderComponent, TransformComponent>();
+}
+
+QueryService::~QueryService()
+{
+}
+
+void QueryService::Terminate()
+{
+	for (AABoxColliderComponent* collider : mColliders)
+	{
+		collider->mQueryProxy = DynamicAABBTree::kNullNode;
+	}
+	mTree.Clear();
+	mColliders.clear();
+}
+
+void QueryService::Update(float dTime)
+{
+	for (AABoxColliderComponent* collider : mColliders)
+	{
+		mTree.MoveProxy(collider->mQueryProxy, collider->GetAABB());
+	}
+}
+
+void QueryService::Register(AABoxColliderComponent* component)
+{
+	ASSERT(component->mQueryProxy == DynamicAABBTree::kNullNode, "[QueryService] Collider registered twice.");
+
+	component->mQueryProxy = mTree.CreateProxy(component->GetAABB(), component);
+	component->mQueryIndex = static_cast<uint32_t>(mColliders.size());
+	mColliders.push_back(component);
+}
+
+void QueryService::Unregister(AABoxColliderComponent* component)
+{
+	if (component->mQueryProxy == DynamicAABBTree::kNullNode)
+	{
+		return;
+	}
+
+	const uint32_t index = component->mQueryIndex;
+	ASSERT(index < mColliders.size() && mColliders[index] == component, "[QueryService] Query index out of sync.");
+	mTree.DestroyProxy(component->mQueryProxy);
+	component->mQueryProxy = DynamicAABBTree::kNullNode;
+
+	// swap and pop
+	mColliders[index] = mColliders.back();
+	mColliders[index]->mQueryIndex = index;
+	mColliders.pop_back();
+}
+
+bool QueryService::Raycast(const Math::Ray& ray, float maxDistance, RaycastHit& hit) const
+{
+	const Math::Ray unitRay = Normalized(ray);
+	const Math::Vector3 invDir(1.0f / unitRay.direction.x, 1.0f / unitRay.direction.y, 1.0f / unitRay.direction.z);
+
+	AABoxColliderComponent* closest = nullptr;
+	float closestDistance = maxDistance;
+	mTree.RayCast(unitRay, maxDistance, [&](int32_t proxy, float distance)
+	{
+		auto collider = static_cast<AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		float hitDistance;
+		if (RayBox(unitRay, invDir, collider->GetAABB(), distance, hitDistance))
+		{
+			// clip the ray, later boxes have to be closer
+			closest = collider;
+			closestDistance = hitDistance;
+			return hitDistance;
+		}
+		return distance;
+	});
+
+	if (closest == nullptr)
+	{
+		return false;
+	}
+
+	hit.object = closest->GetOwner().GetHandle();
+	hit.collider = closest;
+	hit.distance = closestDistance;
+	hit.point = Math::GetPoint(unitRay, closestDistance);
+	return true;
+}
+
+uint32_t QueryService::RaycastAll(const Math::Ray& ray, float maxDistance, std::vector<RaycastHit>& hits) const
+{
+	const Math::Ray unitRay = Normalized(ray);
+	const Math::Vector3 invDir(1.0f / unitRay.direction.x, 1.0f / unitRay.direction.y, 1.0f / unitRay.direction.z);
+
+	const size_t first = hits.size();
+	mTree.RayCast(unitRay, maxDistance, [&](int32_t proxy, float distance)
+	{
+		auto collider = static_cast<AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		float hitDistance;
+		if (RayBox(unitRay, invDir, collider->GetAABB(), distance, hitDistance))
+		{
+			RaycastHit hit;
+			hit.object = collider->GetOwner().GetHandle();
+			hit.collider = collider;
+			hit.distance = hitDistance;
+			hit.point = Math::GetPoint(unitRay, hitDistance);
+			hits.push_back(hit);
+		}
+		return distance;
+	});
+
+	std::sort(hits.begin() + first, hits.end(), [](const RaycastHit& a, const RaycastHit& b)
+	{
+		return a.distance < b.distance;
+	});
+	return static_cast<uint32_t>(hits.size() - first);
+}
+
+uint32_t QueryService::OverlapBox(const Math::AABB& aabb, std::vector<GameObjectHandle>& handles) const
+{
+	uint32_t count = 0;
+	mTree.Query(aabb, [&](int32_t proxy)
+	{
+		auto collider = static_cast<AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		const Math::AABB bounds = collider->GetAABB();
+		if (Math::Abs(bounds.center.x - aabb.center.x) <= bounds.extend.x + aabb.extend.x &&
+			Math::Abs(bounds.center.y - aabb.center.y) <= bounds.extend.y + aabb.extend.y &&
+			Math::Abs(bounds.center.z - aabb.center.z) <= bounds.extend.z + aabb.extend.z)
+		{
+			handles.push_back(collider->GetOwner().GetHandle());
+			++count;
+		}
+	});
+	return count;
+}
+
+uint32_t QueryService::OverlapSphere(const Math::Sphere& sphere, std::vector<GameObjectHandle>& handles) const
+{
+	// the tree is walked with the sphere's box, candidates get the exact test
+	const float radiusSqr = sphere.radius * sphere.radius;
+	const Math::AABB aabb(sphere.center, Math::Vector3(sphere.radius, sphere.radius, sphere.radius));
+	uint32_t count = 0;
+	mTree.Query(aabb, [&](int32_t proxy)
+	{
+		auto collider = static_cast<AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		if (DistanceSqr(sphere.center, collider->GetAABB()) <= radiusSqr)
+		{
+			handles.push_back(collider->GetOwner().GetHandle());
+			++count;
+		}
+	});
+	return count;
+}
+
+uint32_t QueryService::FindNearest(const Math::Vector3& point, uint32_t count, std::vector<GameObjectHandle>& handles, float maxDistance) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	const float maxDistanceSqr = maxDistance * maxDistance;
+	uint32_t found = 0;
+	auto distance = [&](int32_t proxy)
+	{
+		auto collider = static_cast<const AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		return DistanceSqr(point, collider->GetAABB());
+	};
+	mTree.VisitNearest(point, distance, [&](int32_t proxy, float distanceSqr)
+	{
+		if (distanceSqr > maxDistanceSqr)
+		{
+			return false;
+		}
+		auto collider = static_cast<AABoxColliderComponent*>(mTree.GetUserData(proxy));
+		handles.push_back(collider->GetOwner().GetHandle());
+		return ++found < count;
+	});
+	return found;
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Precompiled.h"
+#include "RenderBackend.h"
+
+namespace GameEngine
+{
+
+void NullRenderBackend::Render(const RenderPacket& packet)
+{
+	++mStats.packets;
+	mStats.items += packet.GetItemCount();
+	mStats.boxes += packet.GetBoxCount();
+	mStats.lines += packet.GetLineCount();
+	mStats.commands += static_cast<uint32_t>(packet.commands.size());
+	mStats.lastFrame = packet.frame;
+
+	for (auto& command : packet.commands)
+	{
+		command();
+	}
+}
+
+#if !defined(CORE_HEADLESS)
+void GraphicsRenderBackend::Render(const RenderPacket& packet)
+{
+	Graphics::GraphicsSystem::Get()->BeginRender();
+
+	if (packet.bHasView)
+	{
+		for (uint32_t i = 0; i < packet.listCount; ++i)
+		{
+			const RenderList& list = packet.lists[i];
+			for (auto& box : list.boxes)
+			{
+				Graphics::SimpleDraw::DrawAABB(box.aabb, box.color);
+			}
+			for (auto& line : list.lines)
+			{
+				Graphics::SimpleDraw::DrawLine(line.from, line.to, line.color);
+			}
+		}
+
+		if (packet.bDrawGrid)
+		{
+			for (int i = 0; i < 100; ++i)
+			{
+				Math::Vector3 p0(-50.0f, -0.1f, -50.0f + i);
+				Math::Vector3 p1(+50.0f, -0.1f, -50.0f + i);
+				Graphics::SimpleDraw::DrawLine(p0, p1, Math::Vector4::Gray());
+			}
+			for (int i = 0; i < 100; ++i)
+			{
+				Math::Vector3 p0(-50.0f + i, -0.1f, -50.0f);
+				Math::Vector3 p1(-50.0f + i, -0.1f, +50.0f);
+				Graphics::SimpleDraw::DrawLine(p0, p1, Math::Vector4::Gray());
+			}
+		}
+	}
+
+	// app draws land in the same SimpleDraw flush as the packet's
+	for (auto& command : packet.commands)
+	{
+		command();
+	}
+
+	if (packet.bHasView)
+	{
+		Graphics::SimpleDraw::Flush(packet.view * packet.projection);
+	}
+
+	Graphics::GraphicsSystem::Get()->EndRender();
+}
+#endif // #if !defined(CORE_HEADLESS)
+
+} // namespace GameEngine
\ No newline at end of file
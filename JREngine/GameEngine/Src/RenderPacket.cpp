@@ -0,0 +1,54 @@
+#include "Precompiled.h"
+#include "RenderPacket.h"
+
+namespace GameEngine
+{
+
+void RenderPacket::Reset(uint32_t count)
+{
+	frame = 0;
+	bHasView = false;
+	bDrawGrid = false;
+	commands.clear();
+	if (lists.size() < count)
+	{
+		lists.resize(count);
+	}
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		lists[i].Clear();
+	}
+	listCount = count;
+}
+
+uint32_t RenderPacket::GetItemCount() const
+{
+	size_t count = 0;
+	for (uint32_t i = 0; i < listCount; ++i)
+	{
+		count += lists[i].items.size();
+	}
+	return static_cast<uint32_t>(count);
+}
+
+uint32_t RenderPacket::GetBoxCount() const
+{
+	size_t count = 0;
+	for (uint32_t i = 0; i < listCount; ++i)
+	{
+		count += lists[i].boxes.size();
+	}
+	return static_cast<uint32_t>(count);
+}
+
+uint32_t RenderPacket::GetLineCount() const
+{
+	size_t count = 0;
+	for (uint32_t i = 0; i < listCount; ++i)
+	{
+		count += lists[i].lines.size();
+	}
+	return static_cast<uint32_t>(count);
+}
+
+} // namespace GameEngine
\ No newline at end of file
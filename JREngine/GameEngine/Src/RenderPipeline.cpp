@@ -0,0 +1,139 @@
+#include "Precompiled.h"
+#include "RenderPipeline.h"
+
+namespace GameEngine
+{
+
+RenderPipeline::RenderPipeline()
+	: mWriteIndex(0)
+	, mPendingIndex(kNone)
+	, mRenderingIndex(kNone)
+	, mRenderedCount(0)
+	, bQuit(false)
+{
+}
+
+RenderPipeline::~RenderPipeline()
+{
+	StopThread();
+}
+
+void RenderPipeline::SetBackend(std::unique_ptr<RenderBackend> backend)
+{
+	Flush();
+	mBackend = std::move(backend);
+}
+
+void RenderPipeline::SetThreaded(bool threaded)
+{
+	if (threaded == IsThreaded())
+	{
+		return;
+	}
+
+	if (threaded)
+	{
+		bQuit = false;
+		mThread = std::thread(&RenderPipeline::RenderLoop, this);
+	}
+	else
+	{
+		StopThread();
+	}
+}
+
+RenderPacket& RenderPipeline::BeginPacket()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDone.wait(lock, [this]()
+	{
+		return mPendingIndex != mWriteIndex && mRenderingIndex != mWriteIndex;
+	});
+	return mPackets[mWriteIndex];
+}
+
+void RenderPipeline::Submit()
+{
+	RenderPacket& packet = mPackets[mWriteIndex];
+	if (!IsThreaded())
+	{
+		if (mBackend)
+		{
+			mBackend->Render(packet);
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+		++mRenderedCount;
+		mWriteIndex ^= 1;
+		return;
+	}
+
+	{
+		// the other packet may still be queued if the render thread has not
+		// woken up since the last Submit
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDone.wait(lock, [this]() { return mPendingIndex == kNone; });
+		mPendingIndex = mWriteIndex;
+		mWriteIndex ^= 1;
+	}
+	mWake.notify_one();
+}
+
+void RenderPipeline::Flush()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDone.wait(lock, [this]()
+	{
+		return mPendingIndex == kNone && mRenderingIndex == kNone;
+	});
+}
+
+uint64_t RenderPipeline::GetRenderedCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mRenderedCount;
+}
+
+void RenderPipeline::RenderLoop()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	for (;;)
+	{
+		mWake.wait(lock, [this]() { return bQuit || mPendingIndex != kNone; });
+		if (mPendingIndex == kNone)
+		{
+			// quit once everything submitted has been drawn
+			return;
+		}
+
+		mRenderingIndex = mPendingIndex;
+		mPendingIndex = kNone;
+		mDone.notify_all();
+		lock.unlock();
+
+		if (mBackend)
+		{
+			mBackend->Render(mPackets[mRenderingIndex]);
+		}
+
+		lock.lock();
+		mRenderingIndex = kNone;
+		++mRenderedCount;
+		mDone.notify_all();
+	}
+}
+
+void RenderPipeline::StopThread()
+{
+	if (!mThread.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		bQuit = true;
+	}
+	mWake.notify_one();
+	mThread.join();
+}
+
+} // namespace GameEngine
\ No newline at end of file
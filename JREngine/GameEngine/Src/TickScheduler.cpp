@@ -0,0 +1,80 @@
+#include "Precompiled.h"
+#include "TickScheduler.h"
+
+#include "GameObject.h"
+#include "TransformComponent.h"
+
+namespace GameEngine
+{
+
+TickScheduler::TickScheduler()
+	: mOrigin(Math::Vector3::Zero())
+	, mFrame(0)
+{
+}
+
+void TickScheduler::BeginFrame()
+{
+	++mFrame;
+
+	const uint32_t slice = mFrame % kRebandFrames;
+	for (size_t i = slice; i < mByDistance.size(); i += kRebandFrames)
+	{
+		Reband(mByDistance[i]);
+	}
+}
+
+void TickScheduler::SetBands(std::vector<TickBand> bands)
+{
+	std::sort(bands.begin(), bands.end(), [](const TickBand& a, const TickBand& b)
+	{
+		return a.distance < b.distance;
+	});
+	mBands = std::move(bands);
+
+	for (auto component : mByDistance)
+	{
+		Reband(component);
+	}
+}
+
+void TickScheduler::AddByDistance(Component* component)
+{
+	ASSERT(component->mTickListIndex == Component::kNoTickList, "[TickScheduler] Component added twice.");
+	component->mTickListIndex = static_cast<uint32_t>(mByDistance.size());
+	mByDistance.push_back(component);
+	Reband(component);
+}
+
+void TickScheduler::RemoveByDistance(Component* component)
+{
+	const uint32_t index = component->mTickListIndex;
+	ASSERT(index < mByDistance.size() && mByDistance[index] == component, "[TickScheduler] Component is not ticked by distance.");
+
+	// swap and pop
+	mByDistance[index] = mByDistance.back();
+	mByDistance[index]->mTickListIndex = index;
+	mByDistance.pop_back();
+	component->mTickListIndex = Component::kNoTickList;
+}
+
+void TickScheduler::Reband(Component* component) const
+{
+	const TransformComponent* transform = component->GetOwner().GetComponent<TransformComponent>();
+	uint32_t interval = 1;
+	if (transform)
+	{
+		const float distanceSqr = Math::MagnitudeSqr(transform->GetWorldPosition() - mOrigin);
+		for (const TickBand& band : mBands)
+		{
+			if (distanceSqr < band.distance * band.distance)
+			{
+				break;
+			}
+			interval = band.interval;
+		}
+	}
+	component->mTickInterval = static_cast<uint16_t>(std::min(std::max(interval, 1u), 0xffffu));
+}
+
+} // namespace GameEngine
\ No newline at end of file
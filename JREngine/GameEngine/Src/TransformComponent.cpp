@@ -2,15 +2,68 @@
 #include "TransformComponent.h"
 
 #include "GameObject.h"
+#include "TransformService.h"
+#include "World.h"
+#include "WorldSnapshot.h"
+
+#include <mutex>
 
 namespace GameEngine
 {
 
+namespace
+{
+	// striped, a lock per transform would make every component larger
+	const uint32_t kRebuildLockCount = 64;
+	std::mutex sRebuildLocks[kRebuildLockCount];
+
+	std::mutex& GetRebuildLock(const TransformComponent* transform)
+	{
+		const uintptr_t address = reinterpret_cast<uintptr_t>(transform);
+		return sRebuildLocks[(address / sizeof(TransformComponent)) % kRebuildLockCount];
+	}
+
+	Math::Quaternion LookRotation(const Math::Vector3& forward)
+	{
+		Math::Vector3 look = Math::Normalize(forward);
+		Math::Vector3 side = Math::Cross(Math::Vector3::YAxis(), look);
+		// looking straight up or down, any side axis will do
+		if (Math::MagnitudeSqr(side) < Math::kEpsilon)
+		{
+			side = Math::Vector3::XAxis();
+		}
+		side = Math::Normalize(side);
+		Math::Vector3 up = Math::Cross(look, side);
+
+		return Math::Quaternion::RotationMatrix(Math::Matrix4
+		(
+			side.x, side.y, side.z, 0.0f,
+			up.x, up.y, up.z, 0.0f,
+			look.x, look.y, look.z, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		));
+	}
+}
+
 void TransformComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* node)
+{
+	Record record;
+	CookFunc(node, record);
+	LoadFunc(gameObj, &record, sizeof(record));
+}
+
+void TransformComponent::CloneFunc(GameObject* gameObj, const Component* source)
 {
 	auto newComponent = gameObj->AddComponent<TransformComponent>();
-	auto vec = node->FirstChildElement();
+	auto sourceComponent = static_cast<const TransformComponent*>(source);
+	newComponent->mPosition = sourceComponent->mPosition;
+	newComponent->mRotation = sourceComponent->mRotation;
+	newComponent->mScale = sourceComponent->mScale;
+}
 
+void TransformComponent::CookFunc(const TiXmlNode* node, Record& record)
+{
+	auto vec = node->FirstChildElement();
 	while (vec)
 	{
 		// get each dimension
@@ -22,13 +75,41 @@ void TransformComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* node)
 		float z = static_cast<float>(std::atof(dim->GetText()));
 
 		// set dimension
-		if (std::strcmp(vec->FirstAttribute()->Value(), "Position") == 0)
+		const char* name = vec->FirstAttribute()->Value();
+		Math::Quaternion rotation;
+		bool bHasRotation = false;
+		if (std::strcmp(name, "Position") == 0)
+		{
+			record.position[0] = x;
+			record.position[1] = y;
+			record.position[2] = z;
+		}
+		else if (std::strcmp(name, "Scale") == 0)
 		{
-			newComponent->SetPosition({ x,y,z });
+			record.scale[0] = x;
+			record.scale[1] = y;
+			record.scale[2] = z;
 		}
-		else if (std::strcmp(vec->FirstAttribute()->Value(), "Forward") == 0)
+		else if (std::strcmp(name, "Forward") == 0)
 		{
-			newComponent->SetForward({ x,y,z });
+			rotation = LookRotation({ x, y, z });
+			bHasRotation = true;
+		}
+		else if (std::strcmp(name, "Rotation") == 0)
+		{
+			// euler angles in degrees, applied around z, then x, then y
+			Math::Matrix4 matRot = Math::Matrix4::RotationZ(z * Math::kDegToRad)
+				* Math::Matrix4::RotationX(x * Math::kDegToRad)
+				* Math::Matrix4::RotationY(y * Math::kDegToRad);
+			rotation = Math::Quaternion::RotationMatrix(matRot);
+			bHasRotation = true;
+		}
+		if (bHasRotation)
+		{
+			record.rotation[0] = rotation.x;
+			record.rotation[1] = rotation.y;
+			record.rotation[2] = rotation.z;
+			record.rotation[3] = rotation.w;
 		}
 
 		// move to next vector
@@ -36,9 +117,34 @@ void TransformComponent::CreateFunc(GameObject* gameObj, const TiXmlNode* node)
 	}
 }
 
+void TransformComponent::LoadFunc(GameObject* gameObj, const void* data, uint32_t size)
+{
+	// a stale or corrupt file, adding nothing makes the loader drop the record
+	if (size != sizeof(Record))
+	{
+		LOG("[TransformComponent] Cooked record is %u bytes, expected %u.", size, static_cast<uint32_t>(sizeof(Record)));
+		return;
+	}
+	Record record;
+	std::memcpy(&record, data, sizeof(record));
+
+	auto newComponent = gameObj->AddComponent<TransformComponent>();
+	newComponent->SetPosition({ record.position[0], record.position[1], record.position[2] });
+	newComponent->SetRotation({ record.rotation[0], record.rotation[1], record.rotation[2], record.rotation[3] });
+	newComponent->SetScale({ record.scale[0], record.scale[1], record.scale[2] });
+}
+
 TransformComponent::TransformComponent()
 	: mPosition(Math::Vector3::Zero())
-	, mForward(Math::Vector3::ZAxis())
+	, mRotation(Math::Quaternion::Identity())
+	, mScale(Math::Vector3::One())
+	, mLocal(Math::Matrix4::Identity())
+	, mWorld(Math::Matrix4::Identity())
+	, bLocalDirty(true)
+	, bWorldDirty(true)
+	, mParent(nullptr)
+	, mDepth(0)
+	, mServiceIndex(kNoIndex)
 {
 }
 
@@ -46,21 +152,206 @@ TransformComponent::~TransformComponent()
 {
 }
 
-Math::Matrix4 TransformComponent::GetLocalToWorld() const
+void TransformComponent::Initialize()
+{
+	auto service = GetOwner().GetWorld().GetService<TransformService>();
+	service->Register(this);
+}
+
+void TransformComponent::Terminate()
+{
+	// children stay where their local values put them, now relative to the world
+	for (auto child : mChildren)
+	{
+		child->mParent = nullptr;
+		child->SetDepth(0);
+		child->MarkWorldDirty();
+	}
+	mChildren.clear();
+	SetParent(nullptr);
+
+	auto service = GetOwner().GetWorld().GetService<TransformService>();
+	service->Unregister(this);
+}
+
+void TransformComponent::Serialize(SnapshotWriter& writer) const
+{
+	writer.Write(mPosition);
+	writer.Write(mRotation);
+	writer.Write(mScale);
+	writer.WriteHandle(mParent ? mParent->GetOwner().GetHandle() : GameObjectHandle());
+}
+
+void TransformComponent::Deserialize(SnapshotReader& reader, uint32_t version)
 {
-	Math::Vector3 yAxis = Math::Vector3::YAxis();
-	Math::Vector3 forward = Math::Normalize(mForward);
-	Math::Vector3 side = Math::Cross(yAxis, forward);
-	Math::Vector3 up = Math::Cross(forward, side);
-	Math::Vector3 pos = mPosition;
+	ASSERT(version == 1, "[TransformComponent] Unknown snapshot version.");
+	Math::Vector3 position, scale;
+	Math::Quaternion rotation;
+	reader.Read(position);
+	reader.Read(rotation);
+	reader.Read(scale);
+	GameObject* parentObj = reader.ReadHandle().Get();
+	SetParent(parentObj ? parentObj->GetComponent<TransformComponent>() : nullptr);
 
-	return Math::Matrix4
+	// leave unchanged transforms clean so their subtree is not rebuilt
+	if (std::memcmp(&position, &mPosition, sizeof(position)) != 0 ||
+		std::memcmp(&rotation, &mRotation, sizeof(rotation)) != 0 ||
+		std::memcmp(&scale, &mScale, sizeof(scale)) != 0)
+	{
+		mPosition = position;
+		mRotation = rotation;
+		mScale = scale;
+		MarkLocalDirty();
+	}
+}
+
+void TransformComponent::SetPosition(const Math::Vector3& pos)
+{
+	mPosition = pos;
+	MarkLocalDirty();
+}
+
+void TransformComponent::SetRotation(const Math::Quaternion& rotation)
+{
+	mRotation = Math::Normalize(rotation);
+	MarkLocalDirty();
+}
+
+void TransformComponent::SetScale(const Math::Vector3& scale)
+{
+	mScale = scale;
+	MarkLocalDirty();
+}
+
+void TransformComponent::SetForward(const Math::Vector3& forward)
+{
+	SetRotation(LookRotation(forward));
+}
+
+Math::Vector3 TransformComponent::GetForward() const
+{
+	return Math::GetForward(Math::Matrix4::RotationQuaternion(mRotation));
+}
+
+void TransformComponent::SetParent(TransformComponent* parent)
+{
+	if (parent == mParent)
+	{
+		return;
+	}
+
+	for (auto ancestor = parent; ancestor; ancestor = ancestor->mParent)
+	{
+		ASSERT(ancestor != this, "[TransformComponent] Parenting would create a cycle.");
+	}
+
+	if (mParent)
+	{
+		auto& siblings = mParent->mChildren;
+		siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+	}
+	mParent = parent;
+	if (mParent)
+	{
+		mParent->mChildren.push_back(this);
+	}
+
+	SetDepth(mParent ? mParent->mDepth + 1 : 0);
+	MarkWorldDirty();
+}
+
+const Math::Matrix4& TransformComponent::GetLocalMatrix() const
+{
+	if (bLocalDirty.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(GetRebuildLock(this));
+		UpdateLocal();
+	}
+	return mLocal;
+}
+
+const Math::Matrix4& TransformComponent::GetLocalToWorld() const
+{
+	if (bWorldDirty.load(std::memory_order_acquire))
+	{
+		// parents are clean before children in the service pass, but a read in
+		// between has to bring the chain up to date itself; the parent is done
+		// before this lock is taken, so no thread holds two of them
+		if (mParent)
+		{
+			mParent->GetLocalToWorld();
+		}
+		std::lock_guard<std::mutex> lock(GetRebuildLock(this));
+		// another reader may have rebuilt it while this one waited
+		if (bWorldDirty.load(std::memory_order_relaxed))
+		{
+			UpdateWorld();
+		}
+	}
+	return mWorld;
+}
+
+void TransformComponent::MarkLocalDirty()
+{
+	bLocalDirty = true;
+	MarkWorldDirty();
+}
+
+void TransformComponent::MarkWorldDirty()
+{
+	// a dirty transform already has a dirty subtree
+	if (bWorldDirty)
+	{
+		return;
+	}
+	bWorldDirty = true;
+	for (auto child : mChildren)
+	{
+		child->MarkWorldDirty();
+	}
+}
+
+void TransformComponent::SetDepth(uint32_t depth)
+{
+	if (mDepth == depth)
+	{
+		return;
+	}
+	mDepth = depth;
+	if (mServiceIndex != kNoIndex)
+	{
+		GetOwner().GetWorld().GetService<TransformService>()->MarkOrderDirty();
+	}
+	for (auto child : mChildren)
+	{
+		child->SetDepth(depth + 1);
+	}
+}
+
+void TransformComponent::UpdateLocal() const
+{
+	if (!bLocalDirty.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	// scale * rotation * translation, written out since each step only
+	// touches part of the matrix
+	const Math::Matrix4 rot = Math::Matrix4::RotationQuaternion(mRotation);
+	mLocal = Math::Matrix4
 	(
-		side.x, side.y, side.z, 0.0f,
-		up.x, up.y, up.z, 0.0f,
-		forward.x, forward.y, forward.z, 0.0f,
-		pos.x, pos.y, pos.z, 1.0f
+		rot._11 * mScale.x, rot._12 * mScale.x, rot._13 * mScale.x, 0.0f,
+		rot._21 * mScale.y, rot._22 * mScale.y, rot._23 * mScale.y, 0.0f,
+		rot._31 * mScale.z, rot._32 * mScale.z, rot._33 * mScale.z, 0.0f,
+		mPosition.x, mPosition.y, mPosition.z, 1.0f
 	);
+	bLocalDirty.store(false, std::memory_order_release);
+}
+
+void TransformComponent::UpdateWorld() const
+{
+	UpdateLocal();
+	mWorld = mParent ? mLocal * mParent->mWorld : mLocal;
+	bWorldDirty.store(false, std::memory_order_release);
 }
 
 } // namespace GameEngine
\ No newline at end of file
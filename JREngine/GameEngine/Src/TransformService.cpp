@@ -0,0 +1,99 @@
+#include "Precompiled.h"
+#include "TransformService.h"
+
+#include "TransformComponent.h"
+
+namespace GameEngine
+{
+
+TransformService::TransformService()
+	: mRemovedCount(0)
+	, mUpdatedCount(0)
+	, bOrderDirty(false)
+{
+	// only touches transforms, but has to finish before the physics passes read them
+	mUpdateDesc = UpdateDesc(UpdatePhase::Physics).Writes<TransformComponent>();
+}
+
+TransformService::~TransformService()
+{
+}
+
+void TransformService::Terminate()
+{
+	for (auto transform : mTransforms)
+	{
+		if (transform)
+		{
+			transform->mServiceIndex = TransformComponent::kNoIndex;
+		}
+	}
+	mTransforms.clear();
+	mRemovedCount = 0;
+	bOrderDirty = false;
+}
+
+void TransformService::Update(float dTime)
+{
+	if (bOrderDirty || mRemovedCount > 0)
+	{
+		SortByDepth();
+	}
+
+	// parents come first, so their world matrix is final when a child reads it
+	mUpdatedCount = 0;
+	for (auto transform : mTransforms)
+	{
+		if (transform->bWorldDirty)
+		{
+			transform->UpdateWorld();
+			++mUpdatedCount;
+		}
+	}
+}
+
+void TransformService::Register(TransformComponent* component)
+{
+	ASSERT(component->mServiceIndex == TransformComponent::kNoIndex, "[TransformService] Transform registered twice.");
+	component->mServiceIndex = static_cast<uint32_t>(mTransforms.size());
+	mTransforms.push_back(component);
+
+	// roots can go anywhere, anything deeper may land in front of its parent
+	if (component->mDepth > 0)
+	{
+		bOrderDirty = true;
+	}
+}
+
+void TransformService::Unregister(TransformComponent* component)
+{
+	if (component->mServiceIndex == TransformComponent::kNoIndex)
+	{
+		return;
+	}
+
+	// leave a hole, the next update compacts the array
+	mTransforms[component->mServiceIndex] = nullptr;
+	component->mServiceIndex = TransformComponent::kNoIndex;
+	++mRemovedCount;
+}
+
+void TransformService::SortByDepth()
+{
+	mTransforms.erase(std::remove(mTransforms.begin(), mTransforms.end(), nullptr), mTransforms.end());
+	mRemovedCount = 0;
+
+	// stable so siblings keep their order and unchanged arrays stay put
+	std::stable_sort(mTransforms.begin(), mTransforms.end(), [](const TransformComponent* a, const TransformComponent* b)
+	{
+		return a->mDepth < b->mDepth;
+	});
+
+	for (size_t i = 0; i < mTransforms.size(); ++i)
+	{
+		mTransforms[i]->mServiceIndex = static_cast<uint32_t>(i);
+	}
+	bOrderDirty = false;
+}
+
+} // namespace GameEngine
\ No newline at end of file
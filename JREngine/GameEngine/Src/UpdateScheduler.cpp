@@ -0,0 +1,133 @@
+#include "Precompiled.h"
+#include "UpdateScheduler.h"
+
+namespace GameEngine
+{
+
+UpdateScheduler::UpdateScheduler()
+	: mJobSystem(nullptr)
+	, bParallel(false)
+{
+}
+
+void UpdateScheduler::Clear()
+{
+	for (auto& passes : mPasses)
+	{
+		passes.clear();
+	}
+}
+
+void UpdateScheduler::Add(const UpdateDesc& desc, UpdateFunc func)
+{
+	Pass pass;
+	pass.desc = desc;
+	pass.func = std::move(func);
+	mPasses[static_cast<size_t>(desc.phase)].push_back(std::move(pass));
+}
+
+void UpdateScheduler::Add(ComponentPoolBase* pool, bool bSplit)
+{
+	Pass pass;
+	pass.desc = pool->GetUpdateDesc();
+	pass.pool = pool;
+	pass.bSplit = bSplit;
+	mPasses[static_cast<size_t>(pass.desc.phase)].push_back(std::move(pass));
+}
+
+void UpdateScheduler::Run(UpdatePhase phase, float dTime)
+{
+	ASSERT(!bParallel, "[UpdateScheduler] Run called from inside a pass.");
+
+	// greedily grow a batch until the next pass conflicts with it
+	UpdateDesc batchDesc;
+	mBatch.clear();
+	for (const Pass& pass : mPasses[static_cast<size_t>(phase)])
+	{
+		if (!mBatch.empty() && pass.desc.ConflictsWith(batchDesc))
+		{
+			RunBatch(dTime);
+			mBatch.clear();
+			batchDesc = UpdateDesc();
+		}
+		mBatch.push_back(&pass);
+		batchDesc.readMask |= pass.desc.readMask;
+		batchDesc.writeMask |= pass.desc.writeMask;
+		batchDesc.bExclusive = pass.desc.bExclusive;
+	}
+	RunBatch(dTime);
+	mBatch.clear();
+}
+
+void UpdateScheduler::RunBatch(float dTime)
+{
+	if (mBatch.empty())
+	{
+		return;
+	}
+
+	// exclusive passes always form a batch of one
+	if (mBatch.size() == 1 && !mBatch[0]->bSplit)
+	{
+		const Pass& pass = *mBatch[0];
+		if (pass.pool)
+		{
+			pass.pool->Update(dTime);
+		}
+		else
+		{
+			pass.func(dTime);
+		}
+		return;
+	}
+
+	mJobs.clear();
+	for (const Pass* pass : mBatch)
+	{
+		if (pass->pool && pass->bSplit)
+		{
+			const uint32_t slotCount = pass->pool->GetSlotCount();
+			for (uint32_t begin = 0; begin < slotCount; begin += kSlotsPerJob)
+			{
+				mJobs.push_back({ pass, begin, std::min(begin + kSlotsPerJob, slotCount) });
+			}
+		}
+		else
+		{
+			mJobs.push_back({ pass, 0, 0 });
+		}
+	}
+
+	const auto runJob = [this, dTime](uint32_t jobIndex)
+	{
+		const Job& job = mJobs[jobIndex];
+		if (job.pass->pool == nullptr)
+		{
+			job.pass->func(dTime);
+		}
+		else if (job.pass->bSplit)
+		{
+			job.pass->pool->Update(dTime, job.begin, job.end);
+		}
+		else
+		{
+			job.pass->pool->Update(dTime);
+		}
+	};
+
+	bParallel = true;
+	if (mJobSystem)
+	{
+		mJobSystem->Dispatch(static_cast<uint32_t>(mJobs.size()), runJob);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < mJobs.size(); ++i)
+		{
+			runJob(i);
+		}
+	}
+	bParallel = false;
+}
+
+} // namespace GameEngine
\ No newline at end of file
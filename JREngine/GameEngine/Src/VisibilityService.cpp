@@ -0,0 +1,212 @@
+#include "Precompiled.h"
+#include "VisibilityService.h"
+
+#include "AABoxColliderComponent.h"
+#include "GameObject.h"
+#include "TransformComponent.h"
+#include "World.h"
+
+namespace GameEngine
+{
+
+namespace
+{
+	DynamicAABBTree::Overlap Classify(const Math::Frustum& frustum, const Math::Vector3& min, const Math::Vector3& max)
+	{
+		const Math::Vector3 center = (min + max) * 0.5f;
+		const Math::Vector3 extend = (max - min) * 0.5f;
+		DynamicAABBTree::Overlap result = DynamicAABBTree::Overlap::Inside;
+		for (const Math::Plane& plane : frustum.planes)
+		{
+			const float radius = extend.x * Math::Abs(plane.n.x) + extend.y * Math::Abs(plane.n.y) + extend.z * Math::Abs(plane.n.z);
+			const float distance = Math::Dot(plane.n, center) - plane.d;
+			if (distance + radius < 0.0f)
+			{
+				return DynamicAABBTree::Overlap::Outside;
+			}
+			if (distance - radius < 0.0f)
+			{
+				result = DynamicAABBTree::Overlap::Intersect;
+			}
+		}
+		return result;
+	}
+}
+
+VisibilityService::VisibilityService()
+	: bParallelCull(true)
+{
+	// bounds are read after transforms and physics settled, reading a world
+	// matrix may still rebuild it if something moved late
+	mUpdateDesc = UpdateDesc(UpdatePhase::Late).Reads<AABoxColliderComponent, TransformComponent>();
+}
+
+VisibilityService::~VisibilityService()
+{
+}
+
+void VisibilityService::Terminate()
+{
+	mTree.Clear();
+	mEntries.clear();
+	mUnbounded.clear();
+	mVisible.clear();
+}
+
+void VisibilityService::Update(float dTime)
+{
+	mStats.moved = 0;
+	Math::AABB aabb;
+	for (Entry& entry : mEntries)
+	{
+		// components that report bounds can come and go after Register
+		const bool bBounded = GetBounds(*entry.object, aabb);
+		if (entry.proxy != DynamicAABBTree::kNullNode)
+		{
+			if (bBounded)
+			{
+				mStats.moved += mTree.MoveProxy(entry.proxy, aabb) ? 1 : 0;
+			}
+			else
+			{
+				mTree.DestroyProxy(entry.proxy);
+				AddUnbounded(entry);
+			}
+		}
+		else if (bBounded)
+		{
+			RemoveUnbounded(entry);
+			entry.proxy = mTree.CreateProxy(aabb, entry.object);
+		}
+	}
+}
+
+void VisibilityService::Register(GameObject* gameObj)
+{
+	Entry entry;
+	entry.object = gameObj;
+	entry.proxy = DynamicAABBTree::kNullNode;
+	entry.unboundedIndex = 0;
+
+	Math::AABB aabb;
+	if (GetBounds(*gameObj, aabb))
+	{
+		entry.proxy = mTree.CreateProxy(aabb, gameObj);
+	}
+	else
+	{
+		AddUnbounded(entry);
+	}
+
+	gameObj->mVisibilityIndex = static_cast<uint32_t>(mEntries.size());
+	mEntries.push_back(entry);
+}
+
+void VisibilityService::Unregister(GameObject* gameObj)
+{
+	const uint32_t index = gameObj->mVisibilityIndex;
+	ASSERT(index < mEntries.size() && mEntries[index].object == gameObj, "[VisibilityService] Object is not registered.");
+
+	const Entry& entry = mEntries[index];
+	if (entry.proxy != DynamicAABBTree::kNullNode)
+	{
+		mTree.DestroyProxy(entry.proxy);
+	}
+	else
+	{
+		RemoveUnbounded(entry);
+	}
+
+	// swap and pop
+	mEntries[index] = mEntries.back();
+	mEntries[index].object->mVisibilityIndex = index;
+	mEntries.pop_back();
+}
+
+void VisibilityService::Cull(const Math::Matrix4& viewProjection)
+{
+	const Math::Frustum frustum = Math::Frustum::FromViewProjection(viewProjection);
+	auto test = [&frustum](const Math::Vector3& min, const Math::Vector3& max)
+	{
+		return Classify(frustum, min, max);
+	};
+
+	mVisible.clear();
+	Core::JobSystem* jobSystem = bParallelCull ? &GetOwner().GetJobSystem() : nullptr;
+	if (jobSystem && jobSystem->GetWorkerCount() > 0)
+	{
+		// a few subtrees per thread so uneven ones still balance out
+		mTree.Split((jobSystem->GetWorkerCount() + 1) * 4, mCullRoots);
+		const uint32_t jobCount = static_cast<uint32_t>(mCullRoots.size());
+		if (mJobVisible.size() < jobCount)
+		{
+			mJobVisible.resize(jobCount);
+		}
+		jobSystem->Dispatch(jobCount, [this, &test](uint32_t job)
+		{
+			std::vector<GameObject*>& visible = mJobVisible[job];
+			visible.clear();
+			mTree.Traverse(mCullRoots[job], test, [this, &visible](int32_t proxy)
+			{
+				visible.push_back(static_cast<GameObject*>(mTree.GetUserData(proxy)));
+			});
+		});
+		for (uint32_t i = 0; i < jobCount; ++i)
+		{
+			mVisible.insert(mVisible.end(), mJobVisible[i].begin(), mJobVisible[i].end());
+		}
+	}
+	else
+	{
+		mTree.Traverse(mTree.GetRoot(), test, [this](int32_t proxy)
+		{
+			mVisible.push_back(static_cast<GameObject*>(mTree.GetUserData(proxy)));
+		});
+	}
+
+	mStats.tested = mTree.GetProxyCount();
+	mStats.culled = mStats.tested - static_cast<uint32_t>(mVisible.size());
+	mVisible.insert(mVisible.end(), mUnbounded.begin(), mUnbounded.end());
+	mStats.drawn = static_cast<uint32_t>(mVisible.size());
+}
+
+bool VisibilityService::GetBounds(const GameObject& gameObj, Math::AABB& aabb)
+{
+	// the box around every component's bounds
+	bool bBounded = false;
+	Math::AABB bounds;
+	for (uint32_t i = 0; i < gameObj.mComponents.size(); ++i)
+	{
+		if (gameObj.mComponents[i]->GetBounds(bounds))
+		{
+			if (bBounded)
+			{
+				aabb += bounds.center - bounds.extend;
+				aabb += bounds.center + bounds.extend;
+			}
+			else
+			{
+				aabb = bounds;
+				bBounded = true;
+			}
+		}
+	}
+	return bBounded;
+}
+
+void VisibilityService::AddUnbounded(Entry& entry)
+{
+	entry.proxy = DynamicAABBTree::kNullNode;
+	entry.unboundedIndex = static_cast<uint32_t>(mUnbounded.size());
+	mUnbounded.push_back(entry.object);
+}
+
+void VisibilityService::RemoveUnbounded(const Entry& entry)
+{
+	GameObject* lastUnbounded = mUnbounded.back();
+	mUnbounded[entry.unboundedIndex] = lastUnbounded;
+	mEntries[lastUnbounded->mVisibilityIndex].unboundedIndex = entry.unboundedIndex;
+	mUnbounded.pop_back();
+}
+
+} // namespace GameEngine
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "CameraComponent.h"
 #include "FPControllerComponent.h"
 #include "TransformComponent.h"
+#include "QueryService.h"
+#include "TransformService.h"
 
 namespace GameEngine
 {
@@ -20,138 +22,309 @@ World::~World()
 
 void World::Initialize(uint32_t capacity, OnRegisterComponent registerComponentCB)
 {
-	mGameObjectAllocator = std::make_unique<GameObjectAllocator>(capacity);
-	mGameObjectFactory = std::make_unique<GameObjectFactory>(*mGameObjectAllocator);
+	mGameObjectAllocator = std::make_unique<GameObjectAllocator>(capacity, Core::MemoryCategory::GameObject);
+	mGameObjectFactory = std::make_unique<GameObjectFactory>(*mGameObjectAllocator, *this);
 	mGameObjectHandlePool = std::make_unique<GameObjectHandlePool>(capacity);
+	mLevelStreamer = std::make_unique<LevelStreamer>(*this);
+	SetWorkerCount(Core::JobSystem::GetDefaultWorkerCount());
+#if defined(CORE_HEADLESS)
+	mRenderPipeline.SetBackend(std::make_unique<NullRenderBackend>());
+#else
+	mRenderPipeline.SetBackend(std::make_unique<GraphicsRenderBackend>());
+#endif
 
 	mUpdateList.reserve(capacity);
 	mDestroyList.reserve(capacity);
 
 	registerComponentCB();
+	AddService<TransformService>();
 	AddService<CollisionService>();
-	mGameObjectFactory->Register("CameraComponent", CameraComponent::CreateFunc);
-	mGameObjectFactory->Register("ColliderComponent", AABoxColliderComponent::CreateFunc);
-	mGameObjectFactory->Register("FPControllerComponent",FPControllerComponent::CreateFunc);
-	mGameObjectFactory->Register("TransformComponent", TransformComponent::CreateFunc);
+	AddService<QueryService>();
+	mVisibilityService = AddService<VisibilityService>();
+	mGameObjectFactory->Register("ColliderComponent", AABoxColliderComponent::CreateFunc, AABoxColliderComponent::CloneFunc, AABoxColliderComponent::LoadFunc);
+	mGameObjectFactory->Register("TransformComponent", TransformComponent::CreateFunc, TransformComponent::CloneFunc, TransformComponent::LoadFunc);
+#if !defined(CORE_HEADLESS)
+	mGameObjectFactory->Register("CameraComponent", CameraComponent::CreateFunc, CameraComponent::CloneFunc, CameraComponent::LoadFunc);
+	mGameObjectFactory->Register("FPControllerComponent", FPControllerComponent::CreateFunc, FPControllerComponent::CloneFunc, FPControllerComponent::LoadFunc);
+#endif
 }
 
 void World::Terminate()
 {
 	ASSERT(!bUpdating, "[World] Cannot be terminating during update.");
 
-	bUpdating = true;
+	// stop loading threads before the factory they read from goes away
+	mLevelStreamer.reset();
+	// the last packets are drawn before the graphics system can go away
+	mRenderPipeline.SetThreaded(false);
+	// subscriptions may point at the objects going away
+	mMessageBus.Clear();
+
+	// everything goes, so skip the per-object list maintenance
+	PruneDestroyed();
 	for (auto obj : mUpdateList)
 	{
-		Destroy(obj->GetHandle());
+		mGameObjectHandlePool->Unregister(obj->GetHandle());
+		ReleaseObject(obj);
 	}
-	bUpdating = false;
-	
-	PruneDestroyed();
 	mUpdateList.clear();
+	mNameIndex.clear();
+	mRenderCamera.Invalidate();
+
+	mScheduler.SetJobSystem(nullptr);
+	mScheduler.Clear();
+	mJobSystem.reset();
+	bScheduleDirty = true;
 
 	mGameObjectAllocator.reset();
 	mGameObjectFactory.reset();
 	mGameObjectHandlePool.reset();
+	mComponentPools.clear();
+	mTemplateNames.clear();
+	mTemplateIds.clear();
 }
 
-void World::LoadLevel(const char* levelFileName)
+void World::SetWorkerCount(uint32_t workerCount)
 {
-	TiXmlDocument doc(levelFileName);
-	ASSERT(doc.LoadFile(), "[World] Failed to open level file.");
-
-	TiXmlHandle handleDoc(&doc);
+	ASSERT(!bUpdating, "[World] Cannot change worker threads during update.");
+	mJobSystem = std::make_unique<Core::JobSystem>(workerCount);
+	mScheduler.SetJobSystem(mJobSystem.get());
+}
 
-	// root
-	TiXmlElement* element = handleDoc.FirstChildElement().Element();
-	if (element)
+void World::LoadLevel(const char* levelFileName)
+{
+	std::vector<LevelEntry> entries;
+	if (!ReadLevel(levelFileName, entries))
 	{
-		TiXmlHandle handleRoot = TiXmlHandle(element);
+		LOG("[World] Failed to open level file %s.", levelFileName);
+		return;
+	}
 
-		// load all files
-		element = handleRoot.FirstChild("GameObject").Element();
-		while (element)
-		{
-			TiXmlNode* name = element->FirstChild();
-			TiXmlNode* fileNode = name->NextSibling();
-			auto obj = Create(fileNode->FirstChild()->Value(), name->FirstChild()->Value());
+	for (auto& entry : entries)
+	{
+		Spawn(entry);
+	}
+}
 
-			const auto* overrideNode = fileNode->NextSibling();
-			if (overrideNode)
-			{
-				if (std::strcmp(overrideNode->ToElement()->FirstAttribute()->Value(), "Position") == 0)
-				{
-					if (std::strcmp(name->FirstChild()->Value(), "FPSCamera") == 0)
-					{
-						auto* cameraComp = obj->GetComponent<CameraComponent>();
-						if (cameraComp)
-						{
-							auto xNode = overrideNode->FirstChild();
-							float x = static_cast<float>(std::atof(xNode->FirstChild()->Value()));
-
-							auto yNode = xNode->NextSiblingElement();
-							float y = static_cast<float>(std::atof(yNode->FirstChild()->Value()));
-
-							auto zNode = yNode->NextSiblingElement();
-							float z = static_cast<float>(std::atof(zNode->FirstChild()->Value()));
-							cameraComp->GetCamera().mTransform.SetPosition({ x,y,z });
-						}
-					}
-					else
-					{
-						TransformComponent* transformComp = obj->GetComponent<TransformComponent>();
-						if (transformComp)
-						{
-							auto xNode = overrideNode->FirstChild();
-							float x = static_cast<float>(std::atof(xNode->FirstChild()->Value()));
-
-							auto yNode = xNode->NextSiblingElement();
-							float y = static_cast<float>(std::atof(yNode->FirstChild()->Value()));
-
-							auto zNode = yNode->NextSiblingElement();
-							float z = static_cast<float>(std::atof(zNode->FirstChild()->Value()));
-							transformComp->SetPosition({ x,y,z });
-						}
-					}
-				}
-			}
-			// TODO: Override data for each component
+GameObjectHandle World::Spawn(const LevelEntry& entry)
+{
+	auto handle = Create(entry.templateFileName.c_str(), entry.name.c_str());
+	if (entry.bHasPosition)
+	{
+		SetSpawnPosition(handle.Get(), entry.position);
+	}
+	return handle;
+}
 
-			element = element->NextSiblingElement();
-		}
+void World::SetSpawnPosition(GameObject* gameObj, const Math::Vector3& position)
+{
+#if !defined(CORE_HEADLESS)
+	// cameras keep their own transform
+	auto* cameraComp = gameObj->GetComponent<CameraComponent>();
+	if (cameraComp)
+	{
+		cameraComp->GetCamera().mTransform.SetPosition(position);
+		return;
+	}
+#endif
+	TransformComponent* transformComp = gameObj->GetComponent<TransformComponent>();
+	if (transformComp)
+	{
+		transformComp->SetPosition(position);
 	}
 }
 
 GameObjectHandle World::Create(const char* templateFileName, const char* name)
 {
+	ASSERT(!mScheduler.IsRunningParallel(), "[World] Use CreateDeferred inside parallel update passes.");
+
 	GameObject* object = mGameObjectFactory->Create(templateFileName);
 	ASSERT(object, "[World] Failed to create GameObject.");
 
-	auto handle = mGameObjectHandlePool->Register(object);
+	object->mHandle = mGameObjectHandlePool->Register(object);
+	AddObject(object, GetTemplateId(templateFileName), name);
+	return object->mHandle;
+}
+
+bool World::Recreate(const char* templateFileName, const char* name, GameObjectHandle handle)
+{
+	GameObject* object = mGameObjectFactory->Create(templateFileName);
+	if (object == nullptr)
+	{
+		return false;
+	}
+	if (!mGameObjectHandlePool->Restore(handle, object))
+	{
+		mGameObjectFactory->Destroy(object);
+		return false;
+	}
+
+	object->mHandle = handle;
+	AddObject(object, GetTemplateId(templateFileName), name);
+	return true;
+}
 
+void World::AddObject(GameObject* object, uint32_t templateId, const char* name)
+{
 	object->mWorld = this;
 	object->mName = std::string(name);
-	object->mHandle = handle;
+	object->mTemplateId = templateId;
 	object->Initialize();
+	mVisibilityService->Register(object);
 
+	object->mUpdateIndex = static_cast<uint32_t>(mUpdateList.size());
 	mUpdateList.push_back(object);
+	GameObjectVector& bucket = mNameIndex[Core::HashString(name)];
+	object->mNameIndex = static_cast<uint32_t>(bucket.size());
+	bucket.push_back(object);
 
-	return handle;
+#if !defined(CORE_HEADLESS)
+	if (!mRenderCamera.IsValid() && object->HasComponent<CameraComponent>())
+	{
+		mRenderCamera = object->mHandle;
+	}
+#endif
 }
 
-GameObjectHandle World::Find(const char* name)
+uint32_t World::GetTemplateId(const char* templateFileName)
 {
-	for (auto obj : mUpdateList)
+	const uint32_t hash = Core::HashString(templateFileName);
+	auto iter = mTemplateIds.find(hash);
+	if (iter != mTemplateIds.end())
+	{
+		ASSERT(mTemplateNames[iter->second] == templateFileName, "[World] Template names share a hash.");
+		return iter->second;
+	}
+
+	const uint32_t id = static_cast<uint32_t>(mTemplateNames.size());
+	mTemplateNames.emplace_back(templateFileName);
+	mTemplateIds.emplace(hash, id);
+	return id;
+}
+
+uint32_t World::CreateBatch(const char* templateFileName, const char* name, uint32_t count, std::vector<GameObjectHandle>& handles, const BatchInitializer& initializer)
+{
+	ASSERT(!mScheduler.IsRunningParallel(), "[World] Use CreateDeferred inside parallel update passes.");
+
+	mBatchObjects.clear();
+	const uint32_t created = mGameObjectFactory->CreateBatch(templateFileName, count, mBatchObjects);
+	ASSERT(created == count, "[World] Failed to create GameObjects.");
+	if (created == 0)
 	{
-		if (obj->GetName() == std::string(name))
+		return 0;
+	}
+
+	const uint32_t templateId = GetTemplateId(templateFileName);
+	handles.reserve(handles.size() + created);
+	mUpdateList.reserve(mUpdateList.size() + created);
+	GameObjectVector& bucket = mNameIndex[Core::HashString(name)];
+	bucket.reserve(bucket.size() + created);
+
+	for (uint32_t i = 0; i < created; ++i)
+	{
+		GameObject* object = mBatchObjects[i];
+		object->mHandle = mGameObjectHandlePool->Register(object);
+		object->mName = name;
+		object->mTemplateId = templateId;
+		handles.push_back(object->mHandle);
+		if (initializer)
+		{
+			initializer(i, *object);
+		}
+	}
+
+	// every object has the same component layout, so initialize one
+	// component type at a time
+	const size_t componentCount = mBatchObjects[0]->mComponents.size();
+	for (size_t c = 0; c < componentCount; ++c)
+	{
+		for (auto object : mBatchObjects)
+		{
+			object->mComponents[c]->Initialize();
+		}
+	}
+
+	for (auto object : mBatchObjects)
+	{
+		mVisibilityService->Register(object);
+		object->mUpdateIndex = static_cast<uint32_t>(mUpdateList.size());
+		mUpdateList.push_back(object);
+		object->mNameIndex = static_cast<uint32_t>(bucket.size());
+		bucket.push_back(object);
+	}
+
+#if !defined(CORE_HEADLESS)
+	if (!mRenderCamera.IsValid() && mBatchObjects[0]->HasComponent<CameraComponent>())
+	{
+		mRenderCamera = mBatchObjects[0]->GetHandle();
+	}
+#endif
+
+	mBatchObjects.clear();
+	return created;
+}
+
+GameObjectHandle World::Find(const char* name) const
+{
+	auto iter = mNameIndex.find(Core::HashString(name));
+	if (iter != mNameIndex.end())
+	{
+		// the name is compared as well in case two names share a hash
+		for (auto obj : iter->second)
 		{
-			return obj->GetHandle();
+			if (obj->mName == name)
+			{
+				return obj->GetHandle();
+			}
 		}
 	}
 	return GameObjectHandle();
 }
 
+uint32_t World::FindAll(const char* name, std::vector<GameObjectHandle>& handles) const
+{
+	uint32_t count = 0;
+	auto iter = mNameIndex.find(Core::HashString(name));
+	if (iter != mNameIndex.end())
+	{
+		for (auto obj : iter->second)
+		{
+			if (obj->mName == name)
+			{
+				handles.push_back(obj->GetHandle());
+				++count;
+			}
+		}
+	}
+	return count;
+}
+
+void World::CreateDeferred(const char* templateFileName, const char* name, OnCreated onCreated)
+{
+	if (!bUpdating)
+	{
+		GameObjectHandle handle = Create(templateFileName, name);
+		if (onCreated)
+		{
+			onCreated(handle);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mDeferredMutex);
+	mDeferredCreates.push_back({ templateFileName, name, std::move(onCreated) });
+}
+
 void World::Destroy(GameObjectHandle handle)
 {
+	if (mScheduler.IsRunningParallel())
+	{
+		// handle pool and name index are not thread safe, finish on the main thread
+		std::lock_guard<std::mutex> lock(mDeferredMutex);
+		mDeferredDestroys.push_back(handle);
+		return;
+	}
+
 	if (!handle.IsValid())
 	{
 		return;
@@ -159,8 +332,10 @@ void World::Destroy(GameObjectHandle handle)
 
 	GameObject* obj = handle.Get();
 
-	// mark object and free handle
+	// mark object and free handle, pooled components stop updating right away
 	mGameObjectHandlePool->Unregister(handle);
+	obj->SetComponentsActive(false);
+	RemoveFromNameIndex(obj);
 
 	if (!bUpdating)
 	{
@@ -172,6 +347,69 @@ void World::Destroy(GameObjectHandle handle)
 	}
 }
 
+ComponentPoolBase* World::GetComponentPool(uint32_t typeIndex) const
+{
+	return typeIndex < mComponentPools.size() ? mComponentPools[typeIndex].get() : nullptr;
+}
+
+ComponentPoolBase* World::GetOrAddComponentPool(uint32_t typeIndex, ComponentPoolFactory factory, uint32_t pageSize)
+{
+	if (typeIndex >= mComponentPools.size())
+	{
+		mComponentPools.resize(typeIndex + 1);
+	}
+	if (!mComponentPools[typeIndex])
+	{
+		mComponentPools[typeIndex] = factory(pageSize);
+		mComponentPools[typeIndex]->SetTickScheduler(&mTickScheduler);
+		mComponentPools[typeIndex]->SetProfiler(&mProfiler, typeIndex);
+		mProfiler.RegisterComponentType(typeIndex, mComponentPools[typeIndex]->GetComponentType());
+	}
+	return mComponentPools[typeIndex].get();
+}
+
+uint32_t World::DestroyAll(const Predicate& predicate)
+{
+	if (bUpdating)
+	{
+		// deferred like Destroy, pruned at the end of the update
+		uint32_t count = 0;
+		for (size_t i = 0; i < mUpdateList.size(); ++i)
+		{
+			GameObject* obj = mUpdateList[i];
+			if (obj->GetHandle().IsValid() && predicate(obj))
+			{
+				Destroy(obj->GetHandle());
+				++count;
+			}
+		}
+		return count;
+	}
+
+	// compact the update list in place, keeping the order of survivors
+	uint32_t writeIndex = 0;
+	for (size_t i = 0; i < mUpdateList.size(); ++i)
+	{
+		GameObject* obj = mUpdateList[i];
+		if (predicate(obj))
+		{
+			mGameObjectHandlePool->Unregister(obj->GetHandle());
+			obj->SetComponentsActive(false);
+			RemoveFromNameIndex(obj);
+			ReleaseObject(obj);
+		}
+		else
+		{
+			obj->mUpdateIndex = writeIndex;
+			mUpdateList[writeIndex++] = obj;
+		}
+	}
+
+	const uint32_t count = static_cast<uint32_t>(mUpdateList.size()) - writeIndex;
+	mUpdateList.resize(writeIndex);
+	return count;
+}
+
 void World::Visit(Visitor& visitor)
 {
 	for (auto gameObj : mUpdateList)
@@ -184,70 +422,132 @@ void World::Update(float deltaTime)
 {
 	ASSERT(!bUpdating, "[World] Update already in progress.");
 
-	bUpdating = true;
+	// streamed objects are created before the update so they tick this frame
+	mLevelStreamer->Update();
 
-	for (size_t i = 0; i < mUpdateList.size(); ++i)
+	if (bScheduleDirty)
 	{
-		GameObject* gameObj = mUpdateList[i];
-		// object may have been deleted
-		if (gameObj->GetHandle().IsValid())
-		{
-			gameObj->Update(deltaTime);
-		}
+		RebuildSchedule();
 	}
-	auto numServices = mServices.size();
-	for (size_t i = 0; i < numServices; ++i)
+
+#if !defined(CORE_HEADLESS)
+	// distance bands are measured from the render camera
+	GameObject* cameraObj = mRenderCamera.Get();
+	CameraComponent* cameraComp = cameraObj ? cameraObj->GetComponent<CameraComponent>() : nullptr;
+	if (cameraComp)
 	{
-		mServices[i].get()->Update(deltaTime);
+		mTickScheduler.SetOrigin(cameraComp->GetCamera().mTransform.GetPosition());
+	}
+#endif
+	mTickScheduler.BeginFrame();
+
+	bUpdating = true;
+
+	// creation and destruction requested during a phase are applied between phases
+	for (uint32_t phase = 0; phase < static_cast<uint32_t>(UpdatePhase::Count); ++phase)
+	{
+		mScheduler.Run(static_cast<UpdatePhase>(phase), deltaTime);
+		FlushDeferred();
 	}
 
 	bUpdating = false;
 
 	PruneDestroyed();
+	mProfiler.EndFrame();
+}
+
+void World::SetRenderView(const Math::Matrix4& view, const Math::Matrix4& projection)
+{
+	mRenderView = view;
+	mRenderProjection = projection;
+	bHasRenderView = true;
 }
 
 void World::Render()
 {
-	Graphics::GraphicsSystem::Get()->BeginRender();
+	ASSERT(!bUpdating, "[World] Cannot render during update.");
 
-	auto camera = Find("FPSCamera").Get();
-	if (camera)
+	// waits only if the render thread is still on the packet before last
+	RenderPacket& packet = mRenderPipeline.BeginPacket();
+	Extract(packet);
+	packet.commands.swap(mRenderCommands);
+	mRenderPipeline.Submit();
+}
+
+void World::Extract(RenderPacket& packet)
+{
+	bool bHasView = bHasRenderView;
+	Math::Matrix4 view = mRenderView;
+	Math::Matrix4 projection = mRenderProjection;
+#if !defined(CORE_HEADLESS)
+	GameObject* cameraObj = mRenderCamera.Get();
+	CameraComponent* cameraComp = cameraObj ? cameraObj->GetComponent<CameraComponent>() : nullptr;
+	if (cameraComp)
 	{
-		auto rawcamera = camera->GetComponent<GameEngine::CameraComponent>()->GetCamera();
-		auto cameraTrans = rawcamera.mTransform;
+		Graphics::Camera& camera = cameraComp->GetCamera();
+		view = camera.GetViewMatrix(camera.mTransform);
+		projection = camera.GetProjectionMatrix(Graphics::GraphicsSystem::Get()->GetAspectRatio());
+		bHasView = true;
+	}
+#endif
 
-		Math::Matrix4 viewMatrix = rawcamera.GetViewMatrix(cameraTrans);
-		Math::Matrix4 projectionMatrix = rawcamera.GetProjectionMatrix(Graphics::GraphicsSystem::Get()->GetAspectRatio());
+	if (!bHasView)
+	{
+		packet.Reset(0);
+		packet.frame = mTickScheduler.GetFrame();
+		return;
+	}
 
-		for (auto obj : mUpdateList)
-		{
-			obj->Render();
-		}
+	mVisibilityService->Cull(view * projection);
+	const GameObjectVector& visible = mVisibilityService->GetVisible();
+	const uint32_t visibleCount = static_cast<uint32_t>(visible.size());
 
-		auto numServices = mServices.size();
-		for (size_t i = 0; i < numServices; ++i)
-		{
-			mServices[i].get()->Render();
-		}
+	// a few ranges per thread so objects with heavier components still balance out
+	uint32_t jobCount = 1;
+	if (bParallelExtract && mJobSystem->GetWorkerCount() > 0)
+	{
+		jobCount = std::min((mJobSystem->GetWorkerCount() + 1) * 4, visibleCount / kMinExtractPerJob);
+		jobCount = std::max(jobCount, 1u);
+	}
+
+	// one list per job, the last one for the services
+	packet.Reset(jobCount + 1);
+	packet.frame = mTickScheduler.GetFrame();
+	packet.bHasView = true;
+	packet.bDrawGrid = bDrawGrid;
+	packet.view = view;
+	packet.projection = projection;
 
-		for (int i = 0; i < 100; ++i)
+	if (jobCount > 1)
+	{
+		mJobSystem->Dispatch(jobCount, [&packet, &visible, visibleCount, jobCount](uint32_t job)
 		{
-			Math::Vector3 p0(-50.0f, -0.1f, -50.0f + i);
-			Math::Vector3 p1(+50.0f, -0.1f, -50.0f + i);
-			Graphics::SimpleDraw::DrawLine(p0, p1, Math::Vector4::Gray());
-		}
-		for (int i = 0; i < 100; ++i)
+			const uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(visibleCount) * job / jobCount);
+			const uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(visibleCount) * (job + 1) / jobCount);
+			RenderList& list = packet.lists[job];
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				visible[i]->Extract(list);
+			}
+		});
+	}
+	else
+	{
+		for (auto obj : visible)
 		{
-			Math::Vector3 p0(-50.0f + i, -0.1f, -50.0f);
-			Math::Vector3 p1(-50.0f + i, -0.1f, +50.0f);
-			Graphics::SimpleDraw::DrawLine(p0, p1, Math::Vector4::Gray());
+			obj->Extract(packet.lists[0]);
 		}
-
-		Graphics::SimpleDraw::Flush(viewMatrix * projectionMatrix);
 	}
 
-	Graphics::GraphicsSystem::Get()->EndRender();
-
+	RenderList& serviceList = packet.lists[jobCount];
+	for (size_t i = 0; i < mServices.size(); ++i)
+	{
+		Service* servicePtr = mServices[i].get();
+		mProfiler.TimeService(ProfileStage::Render, static_cast<uint32_t>(i), [servicePtr, &serviceList]()
+		{
+			servicePtr->Extract(serviceList);
+		});
+	}
 }
 
 void World::Render2D()
@@ -259,7 +559,11 @@ void World::Render2D()
 	auto numServices = mServices.size();
 	for (size_t i = 0; i < numServices; ++i)
 	{
-		mServices[i].get()->Render2D();
+		Service* servicePtr = mServices[i].get();
+		mProfiler.TimeService(ProfileStage::Render2D, static_cast<uint32_t>(i), [servicePtr]()
+		{
+			servicePtr->Render2D();
+		});
 	}
 }
 
@@ -272,17 +576,41 @@ void World::DestroyInternal(GameObject* gameObj)
 		return;
 	}
 
-	auto iter = std::find(mUpdateList.begin(), mUpdateList.end(), gameObj);
-	if (iter != mUpdateList.end())
-	{
-		mUpdateList.erase(iter);
-	}
+	// swap and pop, update order is not preserved
+	const uint32_t index = gameObj->mUpdateIndex;
+	ASSERT(index < mUpdateList.size() && mUpdateList[index] == gameObj, "[World] Object is not in the update list.");
+	GameObject* last = mUpdateList.back();
+	mUpdateList[index] = last;
+	last->mUpdateIndex = index;
+	mUpdateList.pop_back();
 
-	gameObj->Terminate();
+	ReleaseObject(gameObj);
+}
 
+void World::ReleaseObject(GameObject* gameObj)
+{
+	mVisibilityService->Unregister(gameObj);
+	gameObj->Terminate();
 	mGameObjectFactory->Destroy(gameObj);
 }
 
+void World::RemoveFromNameIndex(GameObject* gameObj)
+{
+	auto iter = mNameIndex.find(Core::HashString(gameObj->GetName()));
+	ASSERT(iter != mNameIndex.end(), "[World] Object is missing from the name index.");
+
+	// swap and pop so objects sharing a name are removed in constant time
+	GameObjectVector& bucket = iter->second;
+	GameObject* last = bucket.back();
+	bucket[gameObj->mNameIndex] = last;
+	last->mNameIndex = gameObj->mNameIndex;
+	bucket.pop_back();
+	if (bucket.empty())
+	{
+		mNameIndex.erase(iter);
+	}
+}
+
 void World::PruneDestroyed()
 {
 	for (auto obj : mDestroyList)
@@ -292,4 +620,84 @@ void World::PruneDestroyed()
 	mDestroyList.clear();
 }
 
-} // namespace GameEngine
+void World::RebuildSchedule()
+{
+	mScheduler.Clear();
+
+	// other components update through their objects, which can touch anything
+	mScheduler.Add(UpdateDesc(UpdatePhase::PrePhysics).Exclusive(), [this](float dTime)
+	{
+		for (size_t i = 0; i < mUpdateList.size(); ++i)
+		{
+			GameObject* gameObj = mUpdateList[i];
+			// object may have been deleted
+			if (gameObj->GetHandle().IsValid())
+			{
+				gameObj->Update(dTime);
+			}
+		}
+	});
+
+	// scheduled pools, one contiguous pass per type
+	for (size_t i = 0; i < mComponentPools.size(); ++i)
+	{
+		ComponentPoolBase* pool = mComponentPools[i].get();
+		if (pool && pool->IsScheduled())
+		{
+			// instances can only be split up if they do not look at each other
+			const UpdateDesc& desc = pool->GetUpdateDesc();
+			const bool bSplit = !desc.bExclusive && (desc.readMask & ((uint64_t)1 << i)) == 0;
+			mScheduler.Add(pool, bSplit);
+		}
+	}
+
+	for (size_t i = 0; i < mServices.size(); ++i)
+	{
+		Service* servicePtr = mServices[i].get();
+		WorldProfiler* profiler = &mProfiler;
+		const uint32_t serviceIndex = static_cast<uint32_t>(i);
+		mScheduler.Add(servicePtr->GetUpdateDesc(), [servicePtr, profiler, serviceIndex](float dTime)
+		{
+			profiler->TimeService(ProfileStage::Update, serviceIndex, [servicePtr, dTime]()
+			{
+				servicePtr->Update(dTime);
+			});
+		});
+	}
+
+	bScheduleDirty = false;
+}
+
+void World::FlushDeferred()
+{
+	// handlers run first, anything they destroy or create goes out below
+	mMessageBus.Dispatch();
+
+	std::vector<GameObjectHandle> destroys;
+	std::vector<DeferredCreate> creates;
+	{
+		std::lock_guard<std::mutex> lock(mDeferredMutex);
+		destroys.swap(mDeferredDestroys);
+		creates.swap(mDeferredCreates);
+	}
+
+	for (auto handle : destroys)
+	{
+		Destroy(handle);
+	}
+	// objects destroyed during the phase go now, while no pass is iterating
+	bUpdating = false;
+	PruneDestroyed();
+
+	for (auto& create : creates)
+	{
+		GameObjectHandle handle = Create(create.templateFileName.c_str(), create.name.c_str());
+		if (create.onCreated)
+		{
+			create.onCreated(handle);
+		}
+	}
+	bUpdating = true;
+}
+
+} // namespace GameEngine
\ No newline at end of file
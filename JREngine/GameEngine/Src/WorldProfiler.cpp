@@ -0,0 +1,178 @@
+#include "Precompiled.h"
+#include "WorldProfiler.h"
+
+#include <Core/Inc/RTTI.h>
+
+#include <chrono>
+
+namespace GameEngine
+{
+
+namespace
+{
+	const char* const kStageNames[] = { "Update", "Render", "Render2D" };
+}
+
+double WorldProfiler::Record::GetTotalMilliseconds() const
+{
+	double total = 0.0;
+	for (double ms : milliseconds)
+	{
+		total += ms;
+	}
+	return total;
+}
+
+int64_t WorldProfiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+WorldProfiler::Counters::Counters()
+{
+	Reset();
+}
+
+void WorldProfiler::Counters::Reset()
+{
+	for (size_t i = 0; i < kStageCount; ++i)
+	{
+		calls[i].store(0, std::memory_order_relaxed);
+		nanoseconds[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+WorldProfiler::WorldProfiler()
+	: mFrameCount(0)
+	, mReportInterval(0)
+	, bEnabled(false)
+{
+}
+
+void WorldProfiler::RegisterComponentType(uint32_t typeIndex, int type)
+{
+	ASSERT(typeIndex < kMaxComponentTypes, "[WorldProfiler] Too many component types.");
+	mComponents[typeIndex].type = type;
+}
+
+void WorldProfiler::RegisterService(uint32_t serviceIndex, int type)
+{
+	while (mServices.size() <= serviceIndex)
+	{
+		mServices.emplace_back();
+	}
+	mServices[serviceIndex].type = type;
+}
+
+void WorldProfiler::AddComponent(ProfileStage stage, uint32_t typeIndex, uint32_t calls, int64_t nanoseconds)
+{
+	ASSERT(typeIndex < kMaxComponentTypes, "[WorldProfiler] Invalid component type index.");
+	Counters& counters = mComponents[typeIndex];
+	counters.calls[static_cast<size_t>(stage)].fetch_add(calls, std::memory_order_relaxed);
+	counters.nanoseconds[static_cast<size_t>(stage)].fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void WorldProfiler::AddService(ProfileStage stage, uint32_t serviceIndex, int64_t nanoseconds)
+{
+	ASSERT(serviceIndex < mServices.size(), "[WorldProfiler] Invalid service index.");
+	Counters& counters = mServices[serviceIndex];
+	counters.calls[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+	counters.nanoseconds[static_cast<size_t>(stage)].fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void WorldProfiler::EndFrame()
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	++mFrameCount;
+	if (mReportInterval != 0 && mFrameCount >= mReportInterval)
+	{
+		LogReport();
+		Reset();
+	}
+}
+
+void WorldProfiler::GetRecords(std::vector<Record>& records) const
+{
+	records.clear();
+	for (const Counters& counters : mComponents)
+	{
+		AddRecord(counters, false, records);
+	}
+	for (const Counters& counters : mServices)
+	{
+		AddRecord(counters, true, records);
+	}
+
+	std::sort(records.begin(), records.end(), [](const Record& a, const Record& b)
+	{
+		return a.GetTotalMilliseconds() > b.GetTotalMilliseconds();
+	});
+}
+
+void WorldProfiler::LogReport() const
+{
+	std::vector<Record> records;
+	GetRecords(records);
+
+	// per frame averages
+	const double frames = mFrameCount > 0 ? static_cast<double>(mFrameCount) : 1.0;
+	LOGPRINTF("[WorldProfiler] %u frames, per frame averages:\n", mFrameCount);
+	LOGPRINTF("  %-4s %-9s", "Type", "Kind");
+	for (const char* stage : kStageNames)
+	{
+		char calls[32];
+		char ms[32];
+		snprintf(calls, sizeof(calls), "%s calls", stage);
+		snprintf(ms, sizeof(ms), "%s ms", stage);
+		LOGPRINTF(" %16s %11s", calls, ms);
+	}
+	LOGPRINTF("\n");
+	for (const Record& record : records)
+	{
+		LOGPRINTF("  %-4s %-9s", record.name, record.bService ? "Service" : "Component");
+		for (size_t i = 0; i < kStageCount; ++i)
+		{
+			LOGPRINTF(" %16.1f %11.4f", record.calls[i] / frames, record.milliseconds[i] / frames);
+		}
+		LOGPRINTF("\n");
+	}
+}
+
+void WorldProfiler::Reset()
+{
+	for (Counters& counters : mComponents)
+	{
+		counters.Reset();
+	}
+	for (Counters& counters : mServices)
+	{
+		counters.Reset();
+	}
+	mFrameCount = 0;
+}
+
+void WorldProfiler::AddRecord(const Counters& counters, bool bService, std::vector<Record>& records) const
+{
+	Record record;
+	bool bUsed = false;
+	for (size_t i = 0; i < kStageCount; ++i)
+	{
+		record.calls[i] = counters.calls[i].load(std::memory_order_relaxed);
+		record.milliseconds[i] = counters.nanoseconds[i].load(std::memory_order_relaxed) * 1.0e-6;
+		bUsed |= record.calls[i] != 0;
+	}
+	if (!bUsed)
+	{
+		return;
+	}
+
+	Core::TypeIdToString(counters.type, record.name);
+	record.bService = bService;
+	records.push_back(record);
+}
+
+} // namespace GameEngine
\ No newline at end of file
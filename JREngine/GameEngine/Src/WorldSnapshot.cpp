@@ -0,0 +1,393 @@
+#include "Precompiled.h"
+#include "WorldSnapshot.h"
+
+#include "CookedFormat.h"
+#include "World.h"
+
+namespace GameEngine
+{
+
+namespace
+{
+	uint32_t sNextSnapshotId = 1;
+
+	void Pad4(std::vector<uint8_t>& data)
+	{
+		data.resize(Cooked::Align4(static_cast<uint32_t>(data.size())), 0);
+	}
+}
+
+const uint32_t WorldSnapshot::kMagic;
+const uint16_t WorldSnapshot::kVersion;
+const uint32_t WorldSnapshot::kNoString;
+const uint32_t WorldSnapshot::kNotFound;
+
+WorldSnapshot::WorldSnapshot()
+{
+}
+
+void WorldSnapshot::Capture(const World& world)
+{
+	CaptureInternal(world, nullptr);
+}
+
+void WorldSnapshot::CaptureDelta(const World& world, const WorldSnapshot& baseline)
+{
+	ASSERT(!baseline.IsEmpty() && !baseline.IsDelta(), "[WorldSnapshot] Deltas need a full baseline.");
+	ASSERT(&baseline != this, "[WorldSnapshot] A snapshot cannot be its own baseline.");
+	CaptureInternal(world, &baseline);
+}
+
+void WorldSnapshot::CaptureInternal(const World& world, const WorldSnapshot* baseline)
+{
+	ASSERT(!world.bUpdating, "[WorldSnapshot] Cannot capture during update.");
+
+	mData.clear();
+	mStrings.clear();
+	mTypes.clear();
+	mNameOffsets.clear();
+	mTemplateOffsets.assign(world.mTemplateNames.size(), kNoString);
+	mObjectOffsets.clear();
+
+	mData.resize(sizeof(Header), 0);
+	SnapshotWriter writer(mData);
+	uint32_t objectCount = 0;
+
+	for (const GameObject* gameObj : world.mUpdateList)
+	{
+		// destroyed objects waiting to be pruned
+		if (!gameObj->GetHandle().IsValid())
+		{
+			continue;
+		}
+
+		ObjectRecord object;
+		object.handle = gameObj->GetHandle().GetId();
+		object.name = AddString(gameObj->GetName(), Core::HashString(gameObj->GetName()));
+		object.templateName = kNoString;
+		object.componentCount = 0;
+		if (gameObj->mTemplateId != GameObject::kNoTemplate)
+		{
+			uint32_t& offset = mTemplateOffsets[gameObj->mTemplateId];
+			if (offset == kNoString)
+			{
+				offset = AddString(world.mTemplateNames[gameObj->mTemplateId].c_str(), 0);
+			}
+			object.templateName = offset;
+		}
+
+		const uint32_t objectOffset = static_cast<uint32_t>(mData.size());
+		mData.resize(objectOffset + sizeof(ObjectRecord));
+		const uint32_t baselineObject = baseline ? baseline->FindObject(object.handle) : kNotFound;
+
+		for (auto& component : gameObj->mComponents)
+		{
+			const uint32_t recordOffset = static_cast<uint32_t>(mData.size());
+			mData.resize(recordOffset + sizeof(ComponentRecord));
+			component->Serialize(writer);
+
+			// nothing to store for components without hooks
+			const uint32_t size = static_cast<uint32_t>(mData.size()) - recordOffset - sizeof(ComponentRecord);
+			if (size == 0)
+			{
+				mData.resize(recordOffset);
+				continue;
+			}
+
+			const uint8_t* payload = &mData[recordOffset + sizeof(ComponentRecord)];
+			if (baselineObject != kNotFound)
+			{
+				// a delta drops components that match the baseline byte for byte
+				const uint32_t baselineRecord = baseline->FindComponent(baselineObject, component->GetType());
+				if (baselineRecord != kNotFound)
+				{
+					const ComponentRecord& record = baseline->GetComponent(baselineRecord);
+					if (record.size == size &&
+						baseline->GetType(record.type).version == component->GetSnapshotVersion() &&
+						std::memcmp(&baseline->mData[baselineRecord + sizeof(ComponentRecord)], payload, size) == 0)
+					{
+						mData.resize(recordOffset);
+						continue;
+					}
+				}
+			}
+
+			ComponentRecord record;
+			record.type = AddType(*component);
+			record.size = size;
+			std::memcpy(&mData[recordOffset], &record, sizeof(record));
+			Pad4(mData);
+			++object.componentCount;
+		}
+
+		std::memcpy(&mData[objectOffset], &object, sizeof(object));
+		++objectCount;
+	}
+
+	Header header;
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.flags = baseline ? Header::kDelta : 0;
+	header.id = sNextSnapshotId++;
+	header.baselineId = baseline ? baseline->GetId() : 0;
+	header.objectCount = objectCount;
+	header.typeCount = static_cast<uint32_t>(mTypes.size());
+	header.typeOffset = static_cast<uint32_t>(mData.size());
+	header.stringOffset = header.typeOffset + header.typeCount * sizeof(TypeRecord);
+
+	const uint8_t* types = reinterpret_cast<const uint8_t*>(mTypes.data());
+	mData.insert(mData.end(), types, types + mTypes.size() * sizeof(TypeRecord));
+	mData.insert(mData.end(), mStrings.begin(), mStrings.end());
+	std::memcpy(mData.data(), &header, sizeof(header));
+}
+
+bool WorldSnapshot::Restore(World& world, const WorldSnapshot* baseline) const
+{
+	ASSERT(!world.bUpdating, "[WorldSnapshot] Cannot restore during update.");
+	ASSERT(!IsEmpty(), "[WorldSnapshot] Nothing captured.");
+	if (IsDelta())
+	{
+		ASSERT(baseline && baseline->GetId() == GetHeader().baselineId, "[WorldSnapshot] Delta restored without its baseline.");
+	}
+	else
+	{
+		baseline = nullptr;
+	}
+
+	// objects created after the capture go first, freeing their handles
+	world.PruneDestroyed();
+	world.DestroyAll([this](GameObject* gameObj)
+	{
+		return FindObject(gameObj->GetHandle().GetId()) == kNotFound;
+	});
+
+	// bring back the objects destroyed since, so parent handles resolve below
+	bool bComplete = true;
+	const uint32_t objectCount = GetHeader().objectCount;
+	uint32_t offset = sizeof(Header);
+	for (uint32_t i = 0; i < objectCount; ++i, offset = SkipObject(offset))
+	{
+		const ObjectRecord& object = GetObject(offset);
+		const GameObjectHandle handle = GameObjectHandle::FromId(object.handle);
+		if (handle.IsValid())
+		{
+			continue;
+		}
+		if (object.templateName == kNoString || !world.Recreate(GetString(object.templateName), GetString(object.name), handle))
+		{
+			bComplete = false;
+		}
+	}
+
+	offset = sizeof(Header);
+	for (uint32_t i = 0; i < objectCount; ++i, offset = SkipObject(offset))
+	{
+		const ObjectRecord& object = GetObject(offset);
+		GameObject* gameObj = GameObjectHandle::FromId(object.handle).Get();
+		if (gameObj == nullptr)
+		{
+			continue;
+		}
+
+		// the baseline holds everything the delta left out
+		if (baseline)
+		{
+			const uint32_t baselineObject = baseline->FindObject(object.handle);
+			if (baselineObject != kNotFound)
+			{
+				baseline->ReadComponents(baselineObject, *gameObj);
+			}
+		}
+		ReadComponents(offset, *gameObj);
+	}
+
+	return bComplete;
+}
+
+bool WorldSnapshot::SetData(std::vector<uint8_t> data)
+{
+	mObjectOffsets.clear();
+	mData.clear();
+	if (data.size() < sizeof(Header))
+	{
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	const uint64_t typeEnd = static_cast<uint64_t>(header.typeOffset) + static_cast<uint64_t>(header.typeCount) * sizeof(TypeRecord);
+	if (header.magic != kMagic ||
+		header.version != kVersion ||
+		header.typeOffset < sizeof(Header) ||
+		typeEnd != header.stringOffset ||
+		header.stringOffset > data.size() ||
+		(data.size() > header.stringOffset && data.back() != '\0'))
+	{
+		return false;
+	}
+
+	// every record has to lie within the object section
+	const uint32_t stringSize = static_cast<uint32_t>(data.size()) - header.stringOffset;
+	mData.swap(data);
+	uint32_t offset = sizeof(Header);
+	for (uint32_t i = 0; i < header.objectCount; ++i)
+	{
+		if (offset + sizeof(ObjectRecord) > header.typeOffset)
+		{
+			mData.clear();
+			return false;
+		}
+		const ObjectRecord& object = GetObject(offset);
+		if (object.name >= stringSize || (object.templateName != kNoString && object.templateName >= stringSize))
+		{
+			mData.clear();
+			return false;
+		}
+		uint32_t componentOffset = offset + sizeof(ObjectRecord);
+		for (uint32_t c = 0; c < object.componentCount; ++c)
+		{
+			if (componentOffset + sizeof(ComponentRecord) > header.typeOffset)
+			{
+				mData.clear();
+				return false;
+			}
+			const ComponentRecord& record = GetComponent(componentOffset);
+			componentOffset += sizeof(ComponentRecord) + Cooked::Align4(record.size);
+			if (record.type >= header.typeCount || componentOffset > header.typeOffset)
+			{
+				mData.clear();
+				return false;
+			}
+		}
+		offset = componentOffset;
+	}
+	return true;
+}
+
+bool WorldSnapshot::IsDelta() const
+{
+	return !IsEmpty() && (GetHeader().flags & Header::kDelta) != 0;
+}
+
+uint32_t WorldSnapshot::GetId() const
+{
+	return IsEmpty() ? 0 : GetHeader().id;
+}
+
+uint32_t WorldSnapshot::GetObjectCount() const
+{
+	return IsEmpty() ? 0 : GetHeader().objectCount;
+}
+
+uint32_t WorldSnapshot::AddString(const char* str, uint32_t hash)
+{
+	// names repeat across objects, template names are already unique
+	if (hash != 0)
+	{
+		auto iter = mNameOffsets.find(hash);
+		if (iter != mNameOffsets.end() && std::strcmp(&mStrings[iter->second], str) == 0)
+		{
+			return iter->second;
+		}
+	}
+
+	const uint32_t offset = static_cast<uint32_t>(mStrings.size());
+	mStrings.insert(mStrings.end(), str, str + std::strlen(str) + 1);
+	if (hash != 0)
+	{
+		mNameOffsets[hash] = offset;
+	}
+	return offset;
+}
+
+uint32_t WorldSnapshot::AddType(const Component& component)
+{
+	// only a handful of types, a linear search beats hashing
+	const int32_t type = component.GetType();
+	for (uint32_t i = 0; i < mTypes.size(); ++i)
+	{
+		if (mTypes[i].type == type)
+		{
+			return i;
+		}
+	}
+	mTypes.push_back({ type, component.GetSnapshotVersion() });
+	return static_cast<uint32_t>(mTypes.size()) - 1;
+}
+
+const WorldSnapshot::TypeRecord& WorldSnapshot::GetType(uint32_t index) const
+{
+	return *reinterpret_cast<const TypeRecord*>(&mData[GetHeader().typeOffset + index * sizeof(TypeRecord)]);
+}
+
+const char* WorldSnapshot::GetString(uint32_t offset) const
+{
+	return reinterpret_cast<const char*>(&mData[GetHeader().stringOffset + offset]);
+}
+
+uint32_t WorldSnapshot::SkipObject(uint32_t offset) const
+{
+	const uint32_t componentCount = GetObject(offset).componentCount;
+	offset += sizeof(ObjectRecord);
+	for (uint32_t i = 0; i < componentCount; ++i)
+	{
+		offset += sizeof(ComponentRecord) + Cooked::Align4(GetComponent(offset).size);
+	}
+	return offset;
+}
+
+uint32_t WorldSnapshot::FindObject(uint32_t handleId) const
+{
+	if (mObjectOffsets.empty())
+	{
+		const uint32_t objectCount = GetObjectCount();
+		mObjectOffsets.reserve(objectCount);
+		uint32_t offset = sizeof(Header);
+		for (uint32_t i = 0; i < objectCount; ++i, offset = SkipObject(offset))
+		{
+			mObjectOffsets.emplace(GetObject(offset).handle, offset);
+		}
+	}
+
+	auto iter = mObjectOffsets.find(handleId);
+	return iter != mObjectOffsets.end() ? iter->second : kNotFound;
+}
+
+uint32_t WorldSnapshot::FindComponent(uint32_t objectOffset, int32_t type) const
+{
+	const uint32_t componentCount = GetObject(objectOffset).componentCount;
+	uint32_t offset = objectOffset + sizeof(ObjectRecord);
+	for (uint32_t i = 0; i < componentCount; ++i)
+	{
+		const ComponentRecord& record = GetComponent(offset);
+		if (GetType(record.type).type == type)
+		{
+			return offset;
+		}
+		offset += sizeof(ComponentRecord) + Cooked::Align4(record.size);
+	}
+	return kNotFound;
+}
+
+void WorldSnapshot::ReadComponents(uint32_t objectOffset, GameObject& gameObj) const
+{
+	const uint32_t componentCount = GetObject(objectOffset).componentCount;
+	uint32_t offset = objectOffset + sizeof(ObjectRecord);
+	for (uint32_t i = 0; i < componentCount; ++i)
+	{
+		const ComponentRecord& record = GetComponent(offset);
+		const TypeRecord& type = GetType(record.type);
+		for (auto& component : gameObj.mComponents)
+		{
+			if (component->GetType() == type.type)
+			{
+				SnapshotReader reader(&mData[offset + sizeof(ComponentRecord)], record.size);
+				component->Deserialize(reader, type.version);
+				break;
+			}
+		}
+		offset += sizeof(ComponentRecord) + Cooked::Align4(record.size);
+	}
+}
+
+} // namespace GameEngine
\ No newline at end of file
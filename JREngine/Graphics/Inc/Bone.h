@@ -18,8 +18,8 @@ struct Bone
 	int parentIndex;
 	Bone* parent;
 
-	std::vector<uint32_t> childrenIndex;
-	std::vector<Bone*> children;
+	Core::InlineVector<uint32_t, 4> childrenIndex;
+	Core::InlineVector<Bone*, 4> children;
 
 	Math::Matrix4 transform;
 	Math::Matrix4 offsetTransform;
@@ -19,6 +19,7 @@ public:
 
 private:
 	ID3D11ShaderResourceView *mShaderResourceView;
+	size_t mTrackedBytes;
 };
 
 } // namespace Graphics
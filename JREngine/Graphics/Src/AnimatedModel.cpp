@@ -142,7 +142,7 @@ void AnimatedModel::Load(const char* filename)
 	mBoneMatrices.reserve(numBones);
 	for (uint32_t BoneIndex = 0; BoneIndex < numBones; ++BoneIndex)
 	{
-		Bone* bone = new Bone();
+		Bone* bone = New<Bone>(Core::MemoryCategory::Animation);
 		// read name and index
 		char boneName[1024];
 		fscanf_s(file, "Name: %s\n", boneName, 1024);
@@ -156,6 +156,8 @@ void AnimatedModel::Load(const char* filename)
 		// read each child
 		uint32_t numChildren = 0;
 		fscanf_s(file, "ChildCount: %d\n", &numChildren);
+		bone->childrenIndex.reserve(numChildren);
+		bone->children.reserve(numChildren);
 		for (uint32_t i = 0; i < numChildren; ++i)
 		{
 			uint32_t childIdx = 0;
@@ -262,8 +264,11 @@ void AnimatedModel::Unload()
 	}
 	mModelParts.clear();
 	mTextureIds.clear();
+	for (auto& bone : mBones)
+	{
+		SafeDelete(bone, Core::MemoryCategory::Animation);
+	}
 	mBones.clear();
-	SafeDeleteVector(mBones);
 } // void AnimatedModel::Unload()
 
 void AnimatedModel::Play()
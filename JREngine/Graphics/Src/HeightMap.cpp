@@ -23,11 +23,9 @@ void Graphics::HeightMap::Initialize(const char* fileName, unsigned int cols, un
 	mRows = rows;
 
 	std::ifstream file(fileName, std::ios::binary);
-	size_t bytesSize = cols * rows * 4;
-	unsigned char* buffer = new unsigned char[bytesSize];
-	file.read((char*)buffer, bytesSize);
+	mHeightVertices = NewArray<float>(Core::MemoryCategory::Mesh, cols * rows);
+	file.read(reinterpret_cast<char*>(mHeightVertices), cols * rows * sizeof(float));
 	file.close();
-	mHeightVertices = reinterpret_cast<float*>(buffer);
 
 	float tempMin = 0;
 	float tempMax = 0;
@@ -88,7 +86,7 @@ void Graphics::HeightMap::GenerateIndices(uint32_t** indices, int &indexCount)
 
 void Graphics::HeightMap::Terminate()
 {
-	SafeDelete(mHeightVertices);
+	SafeDeleteArray(mHeightVertices, Core::MemoryCategory::Mesh, mColumns * mRows);
 }
 
 float Graphics::HeightMap::GetHeight(uint32_t row, uint32_t col) const
@@ -18,17 +18,18 @@ Mesh::~Mesh()
 
 void Mesh::Allocate(uint32_t numVertices, uint32_t numIndices)
 {
+	// release any previous data with the sizes it was allocated with
+	Destroy();
+
 	mNumVertices = numVertices;
 	mNumIndices = numIndices;
 
-	SafeDeleteArray(mIndices);
-	mIndices = new uint32_t[numIndices];
-	SafeDeleteArray(mVertices);
-	mVertices = new Vertex[numVertices];
+	mIndices = NewArray<uint32_t>(Core::MemoryCategory::Mesh, numIndices);
+	mVertices = NewArray<Vertex>(Core::MemoryCategory::Mesh, numVertices);
 }
 
 void Mesh::Destroy()
 {
-	SafeDeleteArray(mVertices);
-	SafeDeleteArray(mIndices);
+	SafeDeleteArray(mVertices, Core::MemoryCategory::Mesh, mNumVertices);
+	SafeDeleteArray(mIndices, Core::MemoryCategory::Mesh, mNumIndices);
 }
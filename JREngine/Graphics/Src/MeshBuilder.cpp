@@ -26,10 +26,7 @@ void Graphics::MeshBuilder::GenerateStackSliceSphere(Mesh & mesh, const uint32_t
 	const float kSliceOffset = Math::kTwoPi / maxSlices; //offset between slices
 	const float kStackOffset = Math::kPi / (maxStacks - 1); // offset between stacks
 
-	mesh.mNumVertices = kNumVertices;
-	mesh.mVertices = new Vertex[mesh.mNumVertices];
-	mesh.mNumIndices = kNumIndices;
-	mesh.mIndices = new uint32_t[mesh.mNumIndices];
+	mesh.Allocate(kNumVertices, kNumIndices);
 
 	//Fill vertex data
 	float uStep = 1.0f / maxSlices;
@@ -20,16 +20,16 @@ void Graphics::SkinnedMesh::Allocate(uint32_t vertcount, uint32_t intcount)
 	ASSERT(mVertices == nullptr, "[SkinnedMesh] SkinnedMesh already contains vertices");
 	ASSERT(vertcount != 0, "[SkinnedMesh] No vertex allocation size given");
 	ASSERT(intcount != 0, "[SkinnedMesh] No index allocation size given");
-	mVertices = new VertexBone[vertcount];
+	mVertices = NewArray<VertexBone>(Core::MemoryCategory::Mesh, vertcount);
 	mNumVertices = vertcount;
-	mIndices = new uint32_t[intcount];
+	mIndices = NewArray<uint32_t>(Core::MemoryCategory::Mesh, intcount);
 	mNumIndices = intcount;
 }
 
 void Graphics::SkinnedMesh::Terminate()
 {
-	SafeDeleteArray(mVertices);
-	SafeDeleteArray(mIndices);
+	SafeDeleteArray(mVertices, Core::MemoryCategory::Mesh, mNumVertices);
+	SafeDeleteArray(mIndices, Core::MemoryCategory::Mesh, mNumIndices);
 }
 
 
@@ -43,7 +43,7 @@ void Terrain::Initialize(const char* rawFileName, uint32_t cols, uint32_t rows)
 	heightStream.seekg(0, std::ios::beg);
 
 	// Allocate memory and read the data
-	mHeightVertices = new char[mNumHeightVertices];
+	mHeightVertices = NewArray<char>(Core::MemoryCategory::Mesh, mNumHeightVertices);
 	heightStream.read(mHeightVertices, mNumHeightVertices);
 	heightStream.close();
 
@@ -90,7 +90,7 @@ void Terrain::Initialize(const char* rawFileName, uint32_t cols, uint32_t rows)
 
 void Terrain::Terminate()
 {
-	SafeDelete(mHeightVertices);
+	SafeDeleteArray(mHeightVertices, Core::MemoryCategory::Mesh, mNumHeightVertices);
 	mMesh.Destroy();
 	mMeshBuffer.Terminate();
 }
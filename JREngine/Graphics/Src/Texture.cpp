@@ -7,8 +7,39 @@
 
 using namespace Graphics;
 
+#if defined(CORE_MEMORY_TRACKING)
+namespace
+{
+
+// Rough GPU footprint: 4 bytes per texel plus a third for the mip chain
+size_t EstimateTextureSize(ID3D11ShaderResourceView* view)
+{
+	size_t bytes = 0;
+	ID3D11Resource* resource = nullptr;
+	view->GetResource(&resource);
+
+	ID3D11Texture2D* texture = nullptr;
+	if (resource && SUCCEEDED(resource->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&texture))))
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		texture->GetDesc(&desc);
+		bytes = static_cast<size_t>(desc.Width) * desc.Height * 4 * desc.ArraySize;
+		if (desc.MipLevels != 1)
+		{
+			bytes += bytes / 3;
+		}
+		SafeRelease(texture);
+	}
+	SafeRelease(resource);
+	return bytes;
+}
+
+} // namespace
+#endif // #if defined(CORE_MEMORY_TRACKING)
+
 Texture::Texture()
 	: mShaderResourceView(nullptr)
+	, mTrackedBytes(0)
 {
 }
 
@@ -30,6 +61,14 @@ void Texture::Initialize(const wchar_t* filename)
 	{
 		DirectX::CreateWICTextureFromFile(device, context, filename, nullptr, &mShaderResourceView);
 	}
+
+#if defined(CORE_MEMORY_TRACKING)
+	if (mShaderResourceView)
+	{
+		mTrackedBytes = EstimateTextureSize(mShaderResourceView);
+		MEMORY_TRACK_ALLOC(Core::MemoryCategory::Texture, mTrackedBytes);
+	}
+#endif // #if defined(CORE_MEMORY_TRACKING)
 }
 
 void Graphics::Texture::Initialize(const char* fileName)
@@ -41,6 +80,11 @@ void Graphics::Texture::Initialize(const char* fileName)
 
 void Texture::Terminate()
 {
+	if (mTrackedBytes != 0)
+	{
+		MEMORY_TRACK_FREE(Core::MemoryCategory::Texture, mTrackedBytes);
+		mTrackedBytes = 0;
+	}
 	SafeRelease(mShaderResourceView);
 }
 
@@ -44,7 +44,7 @@ TextureManager::~TextureManager()
 	for (auto& item : mInventory)
 	{
 		item.second->Terminate();
-		SafeDelete(item.second);
+		SafeDelete(item.second, Core::MemoryCategory::Texture);
 	}
 	mInventory.clear();
 } // ~TextureManager()
@@ -64,7 +64,7 @@ int TextureManager::Load(const char* filename)
 	auto result = mInventory.insert({ hash, nullptr });
 	if (result.second)
 	{
-		Texture* texture = new Texture();
+		Texture* texture = New<Texture>(Core::MemoryCategory::Texture);
 		texture->Initialize(fullname.c_str());
 		result.first->second = texture;
 	}
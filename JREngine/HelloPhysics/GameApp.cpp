@@ -147,10 +147,7 @@ void GameApp::OnUpdate()
 	{
 		for (int i = 0; i < 50; ++i)
 		{
-			auto p = new Physics::Particle(5.0f);
-			p->SetPosition({ firePoint.pos });
-			p->SetVelocity({ firePoint.dir*0.5f });
-			mPhysicsWorld.AddParticle(p);
+			mPhysicsWorld.AddParticle(firePoint.pos, firePoint.dir*0.5f, 5.0f);
 
 			//Math::Vector3 vec{ Math::Normalize(Math::Vector3{ 0.0f,1.0f,0.0f }) };
 			//Math::Plane plane{ vec.x,vec.y,vec.z,-0.1f };
@@ -3,4 +3,7 @@
 
 #include <Core/Inc/Core.h>
 
+#include <cfloat>
+#include <cmath>
+
 #endif // #ifndef INCLUDED_MATH_COMMON_H
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "Plane.h"
 #include "Ray.h"
 #include "Sphere.h"
+#include "Frustum.h"
 
 // 2D
 #include "Circle.h"
@@ -98,6 +99,8 @@ bool Intersect( const Ray& ray, const AABB& aabb, float& distEntry, float& distE
 bool Intersect( const Ray& ray, const OBB& obb, float& distEntry, float& distExit );
 bool Intersect( const Vector3& point, const AABB& aabb );
 bool Intersect( const Vector3& point, const OBB& obb );
+// conservative, may report boxes just outside a frustum corner as intersecting
+bool Intersect( const Frustum& frustum, const AABB& aabb );
 
 void GetCorners( const OBB& obb, std::vector<Vector3>& corners );
 bool GetContactPoint( const Ray& ray, const OBB& obb, Vector3& point, Vector3& normal );
@@ -111,22 +114,22 @@ Vector3 Mean( const Vector3* v, uint32_t count );
 
 } // namespace Math
 
-constexpr float operator""_pi( long double value )
+inline float operator""_pi( long double value )
 {
 	return ( static_cast<float>( value ) * Math::kPi );
 }
 
-constexpr float operator""_pi( unsigned long long value )
+inline float operator""_pi( unsigned long long value )
 {
 	return ( static_cast<float>( value ) * Math::kPi );
 }
 
-constexpr float operator""_divPi( long double value )
+inline float operator""_divPi( long double value )
 {
 	return ( static_cast<float>( value ) / Math::kPi );
 }
 
-constexpr float operator""_divPi( unsigned long long value )
+inline float operator""_divPi( unsigned long long value )
 {
 	return ( static_cast<float>( value ) / Math::kPi );
 }
@@ -0,0 +1,18 @@
+#ifndef INCLUDED_MATH_FRUSTUM_H
+#define INCLUDED_MATH_FRUSTUM_H
+
+namespace Math {
+
+struct Frustum
+{
+	// facing inward, a point p is inside when Dot(n, p) >= d for every plane
+	enum { Left, Right, Bottom, Top, Near, Far, Count };
+	Plane planes[Count];
+
+	// works for any matrix taking world space to D3D clip space (z from 0 to w)
+	static Frustum FromViewProjection(const Matrix4& viewProj);
+};
+
+} // namespace Math
+
+#endif // #ifndef INCLUDED_MATH_FRUSTUM_H
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 namespace Math {
 
+struct Matrix4;
+
 struct Quaternion
 {
 	float x, y, z, w;
@@ -14,6 +16,8 @@ struct Quaternion
 	static Quaternion Identity();
 	
 	static Quaternion RotationAxis(const Vector3& axis, float rad);
+	// expects a pure rotation in the upper 3x3
+	static Quaternion RotationMatrix(const Matrix4& m);
 
 	Quaternion operator+(const Quaternion& rhs) const;
 	Quaternion operator*(float s) const;
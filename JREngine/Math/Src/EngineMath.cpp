@@ -21,6 +21,57 @@ Quaternion Quaternion::RotationAxis(const Vector3& axis, float rad)
 	return Quaternion(a.x * s, a.y * s, a.z * s, c);
 }
 
+Quaternion Quaternion::RotationMatrix(const Matrix4& m)
+{
+	// inverse of Matrix4::RotationQuaternion, divide by the largest component
+	// to stay away from a near zero divisor
+	const float trace = m._11 + m._22 + m._33;
+	if (trace > 0.0f)
+	{
+		const float s = sqrt(trace + 1.0f) * 2.0f;
+		return Quaternion((m._23 - m._32) / s, (m._31 - m._13) / s, (m._12 - m._21) / s, 0.25f * s);
+	}
+	else if (m._11 > m._22 && m._11 > m._33)
+	{
+		const float s = sqrt(1.0f + m._11 - m._22 - m._33) * 2.0f;
+		return Quaternion(0.25f * s, (m._12 + m._21) / s, (m._31 + m._13) / s, (m._23 - m._32) / s);
+	}
+	else if (m._22 > m._33)
+	{
+		const float s = sqrt(1.0f + m._22 - m._11 - m._33) * 2.0f;
+		return Quaternion((m._12 + m._21) / s, 0.25f * s, (m._23 + m._32) / s, (m._31 - m._13) / s);
+	}
+	else
+	{
+		const float s = sqrt(1.0f + m._33 - m._11 - m._22) * 2.0f;
+		return Quaternion((m._31 + m._13) / s, (m._23 + m._32) / s, 0.25f * s, (m._12 - m._21) / s);
+	}
+}
+
+Frustum Frustum::FromViewProjection(const Matrix4& m)
+{
+	// clip = p * m, so each plane is a sum of matrix columns (Gribb/Hartmann),
+	// a x + b y + c z + w >= 0 on the inside
+	const float coefficients[Count][4] =
+	{
+		{ m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41 },
+		{ m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41 },
+		{ m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42 },
+		{ m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42 },
+		{ m._13, m._23, m._33, m._43 },
+		{ m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43 }
+	};
+
+	Frustum frustum;
+	for (int i = 0; i < Count; ++i)
+	{
+		const float* c = coefficients[i];
+		const float invLength = 1.0f / sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+		frustum.planes[i] = Plane(c[0] * invLength, c[1] * invLength, c[2] * invLength, -c[3] * invLength);
+	}
+	return frustum;
+}
+
 Matrix4 Matrix4::RotationAxis(const Vector3& axis, float rad)
 {
 	const Vector3 u = Normalize(axis);
@@ -360,6 +411,20 @@ bool Math::Intersect(const Vector3& point, const OBB& obb)
 	return Math::Intersect(localPoint, aabb);
 }
 
+bool Math::Intersect(const Frustum& frustum, const AABB& aabb)
+{
+	for (const Plane& plane : frustum.planes)
+	{
+		// distance of the box corner furthest along the plane normal
+		const float radius = aabb.extend.x * abs(plane.n.x) + aabb.extend.y * abs(plane.n.y) + aabb.extend.z * abs(plane.n.z);
+		if (Dot(plane.n, aabb.center) + radius < plane.d)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void Math::GetCorners(const OBB& obb, std::vector<Vector3>& corners)
 {
 	// Compute the local-to-world matrices
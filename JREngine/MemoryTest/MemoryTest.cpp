@@ -136,6 +136,57 @@ public:
 		Assert::IsNotNull(block2);
 		Assert::AreEqual(block->k, block2->k);
 	}
+
+	TEST_METHOD(TestUsageCounters)
+	{
+		BlockAllocator allocator(4, 2);
+
+		void* block = allocator.Allocate();
+		void* block2 = allocator.Allocate();
+		Assert::IsNull(allocator.Allocate());
+		Assert::AreEqual(2u, allocator.GetUsedCount());
+		Assert::AreEqual(1u, allocator.GetFailedAllocationCount());
+
+		allocator.Free(block);
+		allocator.Free(block2);
+		Assert::AreEqual(0u, allocator.GetUsedCount());
+		Assert::AreEqual(2u, allocator.GetPeakUsedCount());
+		Assert::AreEqual(2u, allocator.GetAllocationCount());
+	}
+
+	//---------MemoryTracker---------
+
+	TEST_METHOD(TestTrackerCurrentAndPeak)
+	{
+		MemoryTracker::Reset();
+
+		MemoryTracker::OnAllocate(MemoryCategory::Mesh, 64);
+		MemoryTracker::OnAllocate(MemoryCategory::Mesh, 32);
+		MemoryTracker::OnFree(MemoryCategory::Mesh, 64);
+
+		MemoryStats stats = MemoryTracker::GetStats(MemoryCategory::Mesh);
+		Assert::AreEqual(static_cast<size_t>(32), stats.currentBytes);
+		Assert::AreEqual(static_cast<size_t>(96), stats.peakBytes);
+		Assert::AreEqual(2u, stats.allocationCount);
+		Assert::AreEqual(1u, stats.freeCount);
+
+		MemoryTracker::OnFree(MemoryCategory::Mesh, 32);
+	}
+
+	TEST_METHOD(TestTrackerFrameRate)
+	{
+		MemoryTracker::Reset();
+
+		MemoryTracker::OnAllocate(MemoryCategory::Physics, 16);
+		MemoryTracker::OnAllocate(MemoryCategory::Physics, 16);
+		MemoryTracker::EndFrame();
+		Assert::AreEqual(2u, MemoryTracker::GetStats(MemoryCategory::Physics).frameAllocations);
+
+		MemoryTracker::EndFrame();
+		Assert::AreEqual(0u, MemoryTracker::GetStats(MemoryCategory::Physics).frameAllocations);
+
+		MemoryTracker::OnFree(MemoryCategory::Physics, 32);
+	}
 };
 
 }
\ No newline at end of file
@@ -13,4 +13,5 @@
 // TODO: reference additional headers your program requires here
 
 #include <Core\Inc\BlockAllocator.h>
+#include <Core\Inc\MemoryTracker.h>
 #include <Core\Inc\TypedAllocator.h>
\ No newline at end of file
@@ -4,7 +4,9 @@
 // Engine headers
 #include <Core/Inc/Core.h>
 #include <Math/Inc/EngineMath.h>
-#include <Graphics\Inc\Graphics.h>
+#if !defined(CORE_HEADLESS)
+#include <Graphics/Inc/Graphics.h>
+#endif
 
 // Forwards
 #include "Forward.h"
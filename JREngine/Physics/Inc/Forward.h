@@ -5,6 +5,7 @@ namespace Physics
 
 class Constraint;
 class Particle;
+class ParticleStore;
 class PhysicsPlane;
 class PhysicsOBB;
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <limits>
+
+namespace Physics
+{
+
+// Stable reference to a particle in a ParticleStore, stays valid while other
+// particles come and go
+struct ParticleHandle
+{
+	uint32_t slot = 0xffffffff;
+	uint32_t generation = 0;
+};
+
+/*
+Particles kept as structure of arrays: every field is its own float array,
+32 byte aligned and padded to whole kLaneCount vectors, so Integrate runs
+over them with AVX (or SSE) loads and no tail loop. Live particles stay
+packed at the front; removing one moves the last particle into its place
+and handles find particles through a slot table.
+
+Particles with an inverse mass of 0 are pinned and never move.
+*/
+class ParticleStore
+{
+public:
+	static const uint32_t kLaneCount = 8;
+
+	enum Field
+	{
+		kPositionX, kPositionY, kPositionZ,
+		kPositionOldX, kPositionOldY, kPositionOldZ,
+		kAccelerationX, kAccelerationY, kAccelerationZ,
+		kInvMass,
+		kRadius,
+		kExpireTime,
+		kFieldCount
+	};
+
+	ParticleStore();
+	~ParticleStore();
+
+	ParticleStore(const ParticleStore&) = delete;
+	ParticleStore& operator=(const ParticleStore&) = delete;
+
+	void Reserve(uint32_t capacity);
+
+	ParticleHandle Add(const Math::Vector3& position, const Math::Vector3& velocity = Math::Vector3::Zero(), float invMass = 1.0f, float expireTime = (std::numeric_limits<float>::max)());
+	void Remove(ParticleHandle handle);
+	bool IsValid(ParticleHandle handle) const;
+	void Clear();
+
+	Math::Vector3 GetPosition(ParticleHandle handle) const;
+	// moves the particle without giving it velocity
+	void SetPosition(ParticleHandle handle, const Math::Vector3& position);
+	// displacement per time step, like Particle::SetVelocity
+	Math::Vector3 GetVelocity(ParticleHandle handle) const;
+	void SetVelocity(ParticleHandle handle, const Math::Vector3& velocity);
+	float GetInvMass(ParticleHandle handle) const;
+	void SetInvMass(ParticleHandle handle, float invMass);
+	void SetRadius(ParticleHandle handle, float radius);
+	// accumulated until the next Integrate
+	void AddForce(ParticleHandle handle, const Math::Vector3& force);
+
+	// One Verlet step for every particle: gravity plus the accumulated
+	// forces, velocity scaled by (1 - drag). Clears the forces.
+	void Integrate(const Math::Vector3& gravity, float drag, float timeStep);
+	// returns how many particles expired before time
+	uint32_t RemoveExpired(float time);
+
+	// raw access for batch processing, GetCount() entries in index order
+	uint32_t GetCount() const { return mCount; }
+	uint32_t GetIndex(ParticleHandle handle) const;
+	float* GetData(Field field) { return mFields[field]; }
+	const float* GetData(Field field) const { return mFields[field]; }
+
+	void DebugDraw() const;
+
+private:
+	static const uint32_t kFreeSlot = 0xffffffff;
+
+	struct Slot
+	{
+		uint32_t index; // into the field arrays, kFreeSlot when unused
+		uint32_t generation;
+	};
+
+	void RemoveAt(uint32_t index);
+
+	float* mFields[kFieldCount];
+	void* mBlock; // one allocation holding every field
+	size_t mBlockSize;
+	uint32_t mCount;
+	uint32_t mCapacity; // multiple of kLaneCount
+	std::vector<Slot> mSlots;
+	std::vector<uint32_t> mFreeSlots;
+	std::vector<uint32_t> mIndexToSlot;
+
+}; // class ParticleStore
+
+} // namespace Physics
\ No newline at end of file
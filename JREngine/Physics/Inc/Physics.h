@@ -3,6 +3,7 @@
 #include "Common.h"
 #include "Constraints.h"
 #include "Particle.h"
+#include "ParticleStore.h"
 #include "PhysicsOBB.h"
 #include "PhysicsPlane.h"
 #include "World.h"
\ No newline at end of file
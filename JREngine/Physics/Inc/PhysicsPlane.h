@@ -12,7 +12,11 @@ public:
 
 	void Apply(ParticleVec& particles);
 	void Apply(Particle* particles);
+	void Apply(ParticleStore& store);
 private:
+	// bounces a particle that crossed the plane this step, false if it did not
+	bool Reflect(Math::Vector3& position, Math::Vector3& positionOld) const;
+
 	friend class PhysicsWorld;
 
 	Math::Plane mPlane;
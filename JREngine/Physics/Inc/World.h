@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ParticleStore.h"
+
 namespace Physics
 {
 
@@ -29,6 +31,8 @@ public:
 	void Update(float deltaTime);
 
 	void AddParticle(Particle* p);
+	// particle in the SoA store, the cheaper choice for debris and cloth in bulk
+	ParticleHandle AddParticle(const Math::Vector3& position, const Math::Vector3& velocity, float lifespan = (std::numeric_limits<float>::max)());
 	void AddConstraint(Constraint* c);
 	void AddPhysicsPlane(PhysicsPlane* p);
 	void AddPhysicsOBB(PhysicsOBB* obb);
@@ -38,14 +42,19 @@ public:
 
 	void DebugDraw() const;
 
+	ParticleStore& GetParticleStore() { return mParticleStore; }
+	const ParticleStore& GetParticleStore() const { return mParticleStore; }
+
 private:
 	void AccumulateForces();
 	void Integrate();
 	void SatisfyConstraints();
 	void RemoveExpired();
+	void DeleteParticles();
 
 	Settings mSettings;
 	ParticleVec mParticles;
+	ParticleStore mParticleStore;
 	ConstraintVec mConstraints;
 	PhysicsPlaneVec mPlanes;
 	PhysicsOBBVec mOBBs;
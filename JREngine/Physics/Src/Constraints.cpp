@@ -24,7 +24,9 @@ void Spring::Apply() const
 
 void Spring::DebugDraw() const
 {
+#if !defined(CORE_HEADLESS)
 	Graphics::SimpleDraw::DrawLine(mParticleA->mPosition, mParticleB->mPosition, Math::Vector4::Green());
+#endif
 }
 
 Fixed::Fixed(Particle* p, Math::Vector3 position)
@@ -40,7 +42,9 @@ void Fixed::Apply() const
 
 void Fixed::DebugDraw() const
 {
+#if !defined(CORE_HEADLESS)
 	Graphics::SimpleDraw::DrawSphere(mParticle->mPosition, 4, 4, mParticle->mRadius*1.3f, Math::Vector4::Red());
+#endif
 }
 
 PlaneConstraint::PlaneConstraint(Particle* p, Math::Plane plane, float restitution, float friction)
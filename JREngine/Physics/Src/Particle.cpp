@@ -27,7 +27,9 @@ Particle::Particle(const Math::Vector3& position, float lifespan)
 
 void Particle::DebugDraw() const
 {
+#if !defined(CORE_HEADLESS)
 	Graphics::SimpleDraw::DrawSphere(mPosition, 3, 2, mRadius, Math::Vector4::Cyan());
+#endif
 }
 
 void Particle::SetRadius(float radius)
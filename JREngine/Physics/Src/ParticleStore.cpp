@@ -0,0 +1,344 @@
+#include "Precompiled.h"
+#include "ParticleStore.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace Physics;
+
+namespace
+{
+	const size_t kAlignment = 32;
+
+	uint32_t RoundUpToLanes(uint32_t count)
+	{
+		return (count + ParticleStore::kLaneCount - 1) & ~(ParticleStore::kLaneCount - 1);
+	}
+}
+
+ParticleStore::ParticleStore()
+	: mBlock(nullptr)
+	, mBlockSize(0)
+	, mCount(0)
+	, mCapacity(0)
+{
+	for (auto& field : mFields)
+	{
+		field = nullptr;
+	}
+}
+
+ParticleStore::~ParticleStore()
+{
+	if (mBlock)
+	{
+		MEMORY_TRACK_FREE(Core::MemoryCategory::Physics, mBlockSize);
+		std::free(mBlock);
+	}
+}
+
+void ParticleStore::Reserve(uint32_t capacity)
+{
+	capacity = RoundUpToLanes(capacity);
+	if (capacity <= mCapacity)
+	{
+		return;
+	}
+
+	// one block for all fields, over-allocated so the first one can be aligned
+	const size_t fieldBytes = sizeof(float) * capacity;
+	const size_t blockSize = fieldBytes * kFieldCount + kAlignment;
+	void* block = std::malloc(blockSize);
+	ASSERT(block != nullptr, "[ParticleStore] Failed to allocate particle storage.");
+	MEMORY_TRACK_ALLOC(Core::MemoryCategory::Physics, blockSize);
+
+	const uintptr_t aligned = (reinterpret_cast<uintptr_t>(block) + kAlignment - 1) & ~(kAlignment - 1);
+	for (uint32_t i = 0; i < kFieldCount; ++i)
+	{
+		float* field = reinterpret_cast<float*>(aligned + fieldBytes * i);
+		// padding lanes are zero, inverse mass 0 keeps them in place
+		std::memset(field, 0, fieldBytes);
+		if (mFields[i])
+		{
+			std::memcpy(field, mFields[i], sizeof(float) * mCount);
+		}
+		mFields[i] = field;
+	}
+
+	if (mBlock)
+	{
+		MEMORY_TRACK_FREE(Core::MemoryCategory::Physics, mBlockSize);
+		std::free(mBlock);
+	}
+	mBlock = block;
+	mBlockSize = blockSize;
+	mCapacity = capacity;
+	mIndexToSlot.resize(capacity);
+}
+
+ParticleHandle ParticleStore::Add(const Math::Vector3& position, const Math::Vector3& velocity, float invMass, float expireTime)
+{
+	ASSERT(invMass >= 0.0f, "[ParticleStore] Inverse mass must not be negative.");
+	if (mCount == mCapacity)
+	{
+		Reserve(mCapacity == 0 ? 64 : mCapacity * 2);
+	}
+
+	uint32_t slot;
+	if (mFreeSlots.empty())
+	{
+		slot = static_cast<uint32_t>(mSlots.size());
+		mSlots.push_back({ kFreeSlot, 0 });
+	}
+	else
+	{
+		slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+
+	const uint32_t index = mCount++;
+	mSlots[slot].index = index;
+	mIndexToSlot[index] = slot;
+
+	mFields[kPositionX][index] = position.x;
+	mFields[kPositionY][index] = position.y;
+	mFields[kPositionZ][index] = position.z;
+	mFields[kPositionOldX][index] = position.x - velocity.x;
+	mFields[kPositionOldY][index] = position.y - velocity.y;
+	mFields[kPositionOldZ][index] = position.z - velocity.z;
+	mFields[kAccelerationX][index] = 0.0f;
+	mFields[kAccelerationY][index] = 0.0f;
+	mFields[kAccelerationZ][index] = 0.0f;
+	mFields[kInvMass][index] = invMass;
+	mFields[kRadius][index] = 0.1f;
+	mFields[kExpireTime][index] = expireTime;
+
+	ParticleHandle handle;
+	handle.slot = slot;
+	handle.generation = mSlots[slot].generation;
+	return handle;
+}
+
+void ParticleStore::Remove(ParticleHandle handle)
+{
+	RemoveAt(GetIndex(handle));
+}
+
+bool ParticleStore::IsValid(ParticleHandle handle) const
+{
+	return handle.slot < mSlots.size()
+		&& mSlots[handle.slot].index != kFreeSlot
+		&& mSlots[handle.slot].generation == handle.generation;
+}
+
+void ParticleStore::Clear()
+{
+	while (mCount > 0)
+	{
+		RemoveAt(mCount - 1);
+	}
+}
+
+uint32_t ParticleStore::GetIndex(ParticleHandle handle) const
+{
+	ASSERT(IsValid(handle), "[ParticleStore] Invalid particle handle.");
+	return mSlots[handle.slot].index;
+}
+
+Math::Vector3 ParticleStore::GetPosition(ParticleHandle handle) const
+{
+	const uint32_t index = GetIndex(handle);
+	return { mFields[kPositionX][index], mFields[kPositionY][index], mFields[kPositionZ][index] };
+}
+
+void ParticleStore::SetPosition(ParticleHandle handle, const Math::Vector3& position)
+{
+	const uint32_t index = GetIndex(handle);
+	mFields[kPositionX][index] = mFields[kPositionOldX][index] = position.x;
+	mFields[kPositionY][index] = mFields[kPositionOldY][index] = position.y;
+	mFields[kPositionZ][index] = mFields[kPositionOldZ][index] = position.z;
+}
+
+Math::Vector3 ParticleStore::GetVelocity(ParticleHandle handle) const
+{
+	const uint32_t index = GetIndex(handle);
+	return
+	{
+		mFields[kPositionX][index] - mFields[kPositionOldX][index],
+		mFields[kPositionY][index] - mFields[kPositionOldY][index],
+		mFields[kPositionZ][index] - mFields[kPositionOldZ][index]
+	};
+}
+
+void ParticleStore::SetVelocity(ParticleHandle handle, const Math::Vector3& velocity)
+{
+	const uint32_t index = GetIndex(handle);
+	mFields[kPositionOldX][index] = mFields[kPositionX][index] - velocity.x;
+	mFields[kPositionOldY][index] = mFields[kPositionY][index] - velocity.y;
+	mFields[kPositionOldZ][index] = mFields[kPositionZ][index] - velocity.z;
+}
+
+float ParticleStore::GetInvMass(ParticleHandle handle) const
+{
+	return mFields[kInvMass][GetIndex(handle)];
+}
+
+void ParticleStore::SetInvMass(ParticleHandle handle, float invMass)
+{
+	ASSERT(invMass >= 0.0f, "[ParticleStore] Inverse mass must not be negative.");
+	mFields[kInvMass][GetIndex(handle)] = invMass;
+}
+
+void ParticleStore::SetRadius(ParticleHandle handle, float radius)
+{
+	ASSERT(radius > 0.0f, "[ParticleStore] Radius must be positive and above zero.");
+	mFields[kRadius][GetIndex(handle)] = radius;
+}
+
+void ParticleStore::AddForce(ParticleHandle handle, const Math::Vector3& force)
+{
+	const uint32_t index = GetIndex(handle);
+	const float invMass = mFields[kInvMass][index];
+	mFields[kAccelerationX][index] += force.x * invMass;
+	mFields[kAccelerationY][index] += force.y * invMass;
+	mFields[kAccelerationZ][index] += force.z * invMass;
+}
+
+void ParticleStore::Integrate(const Math::Vector3& gravity, float drag, float timeStep)
+{
+	// position += (position - positionOld) * damping + (acceleration + gravity) * timeStep^2
+	const float damping = 1.0f - drag;
+	const float timeStepSqr = timeStep * timeStep;
+	const float gravityAxis[3] = { gravity.x, gravity.y, gravity.z };
+	const float* invMass = mFields[kInvMass];
+	const uint32_t end = RoundUpToLanes(mCount);
+
+#if defined(__AVX__)
+	const __m256 vDamping = _mm256_set1_ps(damping);
+	const __m256 vTimeStepSqr = _mm256_set1_ps(timeStepSqr);
+	const __m256 vZero = _mm256_setzero_ps();
+	const __m256 vGravity[3] = { _mm256_set1_ps(gravityAxis[0]), _mm256_set1_ps(gravityAxis[1]), _mm256_set1_ps(gravityAxis[2]) };
+	for (uint32_t i = 0; i < end; i += 8)
+	{
+		const __m256 movable = _mm256_cmp_ps(_mm256_load_ps(invMass + i), vZero, _CMP_GT_OQ);
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			float* position = mFields[kPositionX + axis] + i;
+			float* positionOld = mFields[kPositionOldX + axis] + i;
+			float* acceleration = mFields[kAccelerationX + axis] + i;
+
+			const __m256 current = _mm256_load_ps(position);
+			const __m256 velocity = _mm256_mul_ps(_mm256_sub_ps(current, _mm256_load_ps(positionOld)), vDamping);
+			const __m256 push = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(acceleration), vGravity[axis]), vTimeStepSqr);
+			const __m256 displacement = _mm256_and_ps(_mm256_add_ps(velocity, push), movable);
+
+			_mm256_store_ps(positionOld, current);
+			_mm256_store_ps(position, _mm256_add_ps(current, displacement));
+			_mm256_store_ps(acceleration, vZero);
+		}
+	}
+#elif defined(PHYSICS_SSE2)
+	const __m128 vDamping = _mm_set1_ps(damping);
+	const __m128 vTimeStepSqr = _mm_set1_ps(timeStepSqr);
+	const __m128 vZero = _mm_setzero_ps();
+	const __m128 vGravity[3] = { _mm_set1_ps(gravityAxis[0]), _mm_set1_ps(gravityAxis[1]), _mm_set1_ps(gravityAxis[2]) };
+	for (uint32_t i = 0; i < end; i += 4)
+	{
+		const __m128 movable = _mm_cmpgt_ps(_mm_load_ps(invMass + i), vZero);
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			float* position = mFields[kPositionX + axis] + i;
+			float* positionOld = mFields[kPositionOldX + axis] + i;
+			float* acceleration = mFields[kAccelerationX + axis] + i;
+
+			const __m128 current = _mm_load_ps(position);
+			const __m128 velocity = _mm_mul_ps(_mm_sub_ps(current, _mm_load_ps(positionOld)), vDamping);
+			const __m128 push = _mm_mul_ps(_mm_add_ps(_mm_load_ps(acceleration), vGravity[axis]), vTimeStepSqr);
+			const __m128 displacement = _mm_and_ps(_mm_add_ps(velocity, push), movable);
+
+			_mm_store_ps(positionOld, current);
+			_mm_store_ps(position, _mm_add_ps(current, displacement));
+			_mm_store_ps(acceleration, vZero);
+		}
+	}
+#else
+	for (uint32_t i = 0; i < end; ++i)
+	{
+		const bool bMovable = invMass[i] > 0.0f;
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			float& position = mFields[kPositionX + axis][i];
+			float& positionOld = mFields[kPositionOldX + axis][i];
+			float& acceleration = mFields[kAccelerationX + axis][i];
+
+			const float current = position;
+			const float displacement = (current - positionOld) * damping + (acceleration + gravityAxis[axis]) * timeStepSqr;
+			positionOld = current;
+			position = bMovable ? current + displacement : current;
+			acceleration = 0.0f;
+		}
+	}
+#endif
+}
+
+uint32_t ParticleStore::RemoveExpired(float time)
+{
+	const uint32_t countBefore = mCount;
+	const float* expireTime = mFields[kExpireTime];
+	uint32_t index = 0;
+	while (index < mCount)
+	{
+		if (time > expireTime[index])
+		{
+			// the last particle moves into this index, look at it next
+			RemoveAt(index);
+		}
+		else
+		{
+			++index;
+		}
+	}
+	return countBefore - mCount;
+}
+
+void ParticleStore::RemoveAt(uint32_t index)
+{
+	ASSERT(index < mCount, "[ParticleStore] Invalid particle index.");
+
+	Slot& slot = mSlots[mIndexToSlot[index]];
+	slot.index = kFreeSlot;
+	++slot.generation;
+	mFreeSlots.push_back(mIndexToSlot[index]);
+
+	const uint32_t last = --mCount;
+	if (index != last)
+	{
+		for (uint32_t i = 0; i < kFieldCount; ++i)
+		{
+			mFields[i][index] = mFields[i][last];
+		}
+		mIndexToSlot[index] = mIndexToSlot[last];
+		mSlots[mIndexToSlot[index]].index = index;
+	}
+
+	// back to a padding lane
+	for (uint32_t i = 0; i < kFieldCount; ++i)
+	{
+		mFields[i][last] = 0.0f;
+	}
+}
+
+void ParticleStore::DebugDraw() const
+{
+#if !defined(CORE_HEADLESS)
+	for (uint32_t i = 0; i < mCount; ++i)
+	{
+		const Math::Vector3 position(mFields[kPositionX][i], mFields[kPositionY][i], mFields[kPositionZ][i]);
+		Graphics::SimpleDraw::DrawSphere(position, 3, 2, mFields[kRadius][i], Math::Vector4::Cyan());
+	}
+#endif
+}
\ No newline at end of file
@@ -133,6 +133,7 @@ void Physics::PhysicsOBB::Apply(ParticleVec& particles)
 
 void PhysicsOBB::DebugDraw()
 {
+#if !defined(CORE_HEADLESS)
 	auto rotMat = Math::Matrix4::RotationQuaternion(mOBB.rot);
 	auto xExtend = Vector3(mOBB.extend.x, 0.0f, 0.0f);
 	xExtend = Math::TransformCoord(xExtend, rotMat);
@@ -166,6 +167,7 @@ void PhysicsOBB::DebugDraw()
 	Graphics::SimpleDraw::DrawLine(bot2, bot3, Vector4::Orange());
 	Graphics::SimpleDraw::DrawLine(bot3, bot4, Vector4::Orange());
 	Graphics::SimpleDraw::DrawLine(bot4, bot1, Vector4::Orange());
+#endif
 }
 
 void Physics::PhysicsOBB::SetMaxExtend()
@@ -2,6 +2,7 @@
 #include "PhysicsPlane.h"
 
 #include "Particle.h"
+#include "ParticleStore.h"
 
 using namespace Physics;
 
@@ -29,16 +30,45 @@ void Physics::PhysicsPlane::Apply(ParticleVec& particles)
 
 void Physics::PhysicsPlane::Apply(Particle* particle)
 {
-	Physics::Particle par = *particle;
+	Reflect(particle->mPosition, particle->mPositionOld);
+}
+
+void Physics::PhysicsPlane::Apply(ParticleStore& store)
+{
+	float* x = store.GetData(ParticleStore::kPositionX);
+	float* y = store.GetData(ParticleStore::kPositionY);
+	float* z = store.GetData(ParticleStore::kPositionZ);
+	float* oldX = store.GetData(ParticleStore::kPositionOldX);
+	float* oldY = store.GetData(ParticleStore::kPositionOldY);
+	float* oldZ = store.GetData(ParticleStore::kPositionOldZ);
+	const uint32_t count = store.GetCount();
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Math::Vector3 position(x[i], y[i], z[i]);
+		Math::Vector3 positionOld(oldX[i], oldY[i], oldZ[i]);
+		if (Reflect(position, positionOld))
+		{
+			x[i] = position.x;
+			y[i] = position.y;
+			z[i] = position.z;
+			oldX[i] = positionOld.x;
+			oldY[i] = positionOld.y;
+			oldZ[i] = positionOld.z;
+		}
+	}
+}
+
+bool Physics::PhysicsPlane::Reflect(Math::Vector3& position, Math::Vector3& positionOld) const
+{
 	// project position vector onto plane normal
-	float distance{ Math::Dot(mPlane.n, par.mPosition) };
-	float distanceOld{ Math::Dot(mPlane.n, par.mPositionOld) };
+	float distance{ Math::Dot(mPlane.n, position) };
+	float distanceOld{ Math::Dot(mPlane.n, positionOld) };
 
 	// if distance is less than plane radius, the point is below the plane.
 	if (distance < mPlane.d && distanceOld >= mPlane.d)
 	{
 		// Calculate velocity
-		auto velocity = par.mPosition - par.mPositionOld;
+		auto velocity = position - positionOld;
 
 		// Calculate reflection vector
 		auto velocityVert = (mPlane.n * (Math::Dot(velocity, mPlane.n)));
@@ -47,7 +77,7 @@ void Physics::PhysicsPlane::Apply(Particle* particle)
 		auto reflectionVert = (mPlane.n * (Math::Dot(reflection, mPlane.n)));
 
 		// Move particle position above plane
-		particle->mPosition += reflectionVert;
+		position += reflectionVert;
 
 		// Apply friction and restitution variables to reflection
 		auto reflectionHor = reflection - reflectionVert;
@@ -71,6 +101,8 @@ void Physics::PhysicsPlane::Apply(Particle* particle)
 		reflection = reflectionVert + reflectionHor;
 
 		// Move particle old position
-		particle->SetVelocity(reflection);
+		positionOld = position - reflection;
+		return true;
 	}
+	return false;
 }
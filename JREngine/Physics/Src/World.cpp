@@ -27,6 +27,7 @@ void PhysicsWorld::Update(float deltaTime)
 		mTimer -= mSettings.timeStep;
 		AccumulateForces();
 		Integrate();
+		mParticleStore.Integrate(mSettings.gravity, mSettings.drag, mSettings.timeStep);
 		SatisfyConstraints();
 		RemoveExpired(); // TODO: Add support for constraint removal
 	}
@@ -36,6 +37,14 @@ void PhysicsWorld::AddParticle(Particle* p)
 {
 	p->mCreationTime = mWorldTime;
 	mParticles.push_back(p);
+	// the world owns the particle from here on
+	MEMORY_TRACK_ALLOC(Core::MemoryCategory::Physics, sizeof(Particle));
+}
+
+ParticleHandle PhysicsWorld::AddParticle(const Math::Vector3& position, const Math::Vector3& velocity, float lifespan)
+{
+	// a huge lifespan saturates at the largest float, never expiring
+	return mParticleStore.Add(position, velocity, 1.0f, mWorldTime + lifespan);
 }
 
 void PhysicsWorld::AddConstraint(Constraint* c)
@@ -188,7 +197,8 @@ void Physics::PhysicsWorld::AddCube(Physics::PhysicsWorld& world, Math::Vector3
 // Clears all pointer containers
 void PhysicsWorld::ClearDynamic()
 {
-	SafeDeleteVector(mParticles);
+	DeleteParticles();
+	mParticleStore.Clear();
 	SafeDeleteVector(mConstraints);
 	SafeDeleteVector(mPlanes);
 	SafeDeleteVector(mOBBs);
@@ -197,7 +207,8 @@ void PhysicsWorld::ClearDynamic()
 // Clears particle and constraint containers
 void PhysicsWorld::ClearParticles()
 {
-	SafeDeleteVector(mParticles);
+	DeleteParticles();
+	mParticleStore.Clear();
 	SafeDeleteVector(mConstraints);
 }
 
@@ -207,6 +218,7 @@ void PhysicsWorld::DebugDraw() const
 	{
 		p->DebugDraw();
 	}
+	mParticleStore.DebugDraw();
 	for (const auto c : mConstraints)
 	{
 		c->DebugDraw();
@@ -228,9 +240,10 @@ void PhysicsWorld::AccumulateForces()
 void PhysicsWorld::Integrate()
 {
 	const float timeStepSqr = Math::Sqr(mSettings.timeStep);
+	const float damping = 1.0f - mSettings.drag;
 	for (auto p : mParticles)
 	{
-		Math::Vector3 displacement{ p->mPosition - p->mPositionOld + (p->mAcceleration * timeStepSqr) };
+		Math::Vector3 displacement{ (p->mPosition - p->mPositionOld) * damping + (p->mAcceleration * timeStepSqr) };
 		p->mPositionOld = p->mPosition;
 		p->mPosition = p->mPosition + displacement;
 	}
@@ -246,6 +259,7 @@ void PhysicsWorld::SatisfyConstraints()
 	for (auto p : mPlanes)
 	{
 		p->Apply(mParticles);
+		p->Apply(mParticleStore);
 	}
 
 	for (auto o : mOBBs)
@@ -269,4 +283,14 @@ void PhysicsWorld::RemoveExpired()
 			++i;
 		}
 	}
+	mParticleStore.RemoveExpired(mWorldTime);
 }
+
+void PhysicsWorld::DeleteParticles()
+{
+	for (auto& p : mParticles)
+	{
+		SafeDelete(p, Core::MemoryCategory::Physics);
+	}
+	mParticles.clear();
+}
\ No newline at end of file
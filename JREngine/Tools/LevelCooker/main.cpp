@@ -0,0 +1,50 @@
+#include <GameEngine\Inc\GameEngine.h>
+
+#include <cstdio>
+
+using namespace GameEngine;
+
+void PrintHelp()
+{
+	printf(
+		"== LevelCooker Help ==\n"
+		"\n"
+		"Converts XML GameObject templates and levels to the cooked binary format.\n"
+		"Each file is written next to its source with the %s extension, template\n"
+		"references inside levels point at the cooked templates.\n"
+		"\n"
+		"Usage:\n"
+		"\n"
+		"\tLevelCooker.exe <InputFile> [<InputFile> ...]\n"
+		"\n",
+		Cooked::kExtension
+	);
+}
+
+int main(int argc, char* argv[])
+{
+	// We need at least 2 arguments
+	if (argc < 2)
+	{
+		PrintHelp();
+		return -1;
+	}
+
+	Cooker cooker;
+	int failed = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string cookedFileName = Cooked::GetCookedFileName(argv[i]);
+		if (cooker.Cook(argv[i], cookedFileName.c_str()))
+		{
+			printf("Cooked %s -> %s\n", argv[i], cookedFileName.c_str());
+		}
+		else
+		{
+			printf("Failed to cook %s.\n", argv[i]);
+			++failed;
+		}
+	}
+
+	return failed == 0 ? 0 : -1;
+}
\ No newline at end of file